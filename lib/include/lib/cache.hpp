@@ -7,6 +7,7 @@
 #include "lib/spotify/album.hpp"
 #include "lib/spotify/trackinfo.hpp"
 #include "lib/crash/crashinfo.hpp"
+#include "lib/cache/playlistindex.hpp"
 
 namespace lib
 {
@@ -21,6 +22,12 @@ namespace lib
 		 */
 		cache() = default;
 
+		/**
+		 * Caches are owned through a base class pointer,
+		 * like json_cache and binary_cache in the main window
+		 */
+		virtual ~cache() = default;
+
 		//region album
 
 		/**
@@ -91,6 +98,12 @@ namespace lib
 		 */
 		virtual void set_playlist(const spt::playlist &playlist) = 0;
 
+		/**
+		 * Get index of all cached playlists, updated when a playlist is set
+		 * @note Reference is only valid until the next playlist is set
+		 */
+		virtual auto get_playlist_index() const -> const lib::playlist_index & = 0;
+
 		//endregion
 
 		//region tracks
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "lib/cache/jsoncache.hpp"
+
+namespace lib
+{
+	/**
+	 * Cache with tracks stored in a compact binary format,
+	 * everything else is stored as JSON files
+	 */
+	class binary_cache: public json_cache
+	{
+	public:
+		/**
+		 * Instance a new binary cache manager, does not create any directories
+		 * @param paths Paths to get cache directory
+		 */
+		explicit binary_cache(const lib::paths &paths);
+
+		/**
+		 * Get tracks, tracks previously cached as JSON are converted on first load
+		 */
+		auto get_tracks(const std::string &entity_id) const -> std::vector<lib::spt::track> override;
+		void set_tracks(const std::string &entity_id,
+			const std::vector<lib::spt::track> &tracks) override;
+		auto all_tracks() const -> std::map<std::string, std::vector<lib::spt::track>> override;
+
+		/**
+		 * Serialize tracks to binary format
+		 */
+		static auto serialize(const std::vector<lib::spt::track> &tracks)
+		-> std::vector<unsigned char>;
+
+		/**
+		 * Deserialize tracks from binary format
+		 * @return Tracks, or empty if data is invalid
+		 */
+		static auto deserialize(const std::vector<unsigned char> &data)
+		-> std::vector<lib::spt::track>;
+
+	private:
+		/**
+		 * Current version of binary format,
+		 * files with any other version are ignored
+		 */
+		static constexpr unsigned int version = 1;
+
+		/**
+		 * Tracks still saving in the background, by entity ID
+		 */
+		struct pending_tracks
+		{
+			std::mutex mutex;
+			std::map<std::string, std::shared_ptr<const std::vector<lib::spt::track>>> items;
+		};
+
+		/**
+		 * Shared, so it's kept until all saves have finished
+		 */
+		std::shared_ptr<pending_tracks> pending;
+
+		/**
+		 * Write tracks to binary file in the background
+		 */
+		void save_tracks(const std::string &entity_id,
+			const std::vector<lib::spt::track> &tracks) const;
+
+		/**
+		 * Convert tracks cached as JSON to binary
+		 */
+		auto migrate_tracks(const std::string &entity_id) const -> std::vector<lib::spt::track>;
+	};
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Writes little-endian binary data to a buffer
+	 */
+	class binary_writer
+	{
+	public:
+		binary_writer() = default;
+
+		void write_u8(uint8_t value);
+		void write_u32(uint32_t value);
+
+		/**
+		 * Write string, prefixed by its length
+		 */
+		void write_string(const std::string &value);
+
+		/**
+		 * Write all data from another writer
+		 */
+		void write(const binary_writer &writer);
+
+		auto data() const -> const std::vector<unsigned char> &;
+
+	private:
+		std::vector<unsigned char> buffer;
+	};
+
+	/**
+	 * Reads little-endian binary data from a buffer
+	 * @throws std::out_of_range If reading past end of buffer
+	 */
+	class binary_reader
+	{
+	public:
+		explicit binary_reader(const std::vector<unsigned char> &data);
+
+		auto read_u8() -> uint8_t;
+		auto read_u32() -> uint32_t;
+		auto read_string() -> std::string;
+
+		/**
+		 * Read a count of items, where each item is at least item_size bytes,
+		 * verified to not be larger than the remaining data
+		 */
+		auto read_count(size_t item_size) -> uint32_t;
+
+		/**
+		 * Reached end of buffer
+		 */
+		auto at_end() const -> bool;
+
+	private:
+		const std::vector<unsigned char> &data;
+		size_t position = 0;
+
+		void require(size_t size) const;
+	};
+
+	/**
+	 * Table of unique strings, referenced by index
+	 */
+	class string_table
+	{
+	public:
+		string_table() = default;
+
+		/**
+		 * Get index of string, adding it if it's not already in the table
+		 */
+		auto index_of(const std::string &value) -> uint32_t;
+
+		/**
+		 * Get string at index
+		 * @throws std::out_of_range If index is not in table
+		 */
+		auto at(uint32_t index) const -> const std::string &;
+
+		void write(binary_writer &writer) const;
+		void read(binary_reader &reader);
+
+	private:
+		std::vector<std::string> strings;
+		std::unordered_map<std::string, uint32_t> indices;
+	};
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "thirdparty/filesystem.hpp"
+#include "thirdparty/json.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace lib
+{
+	/**
+	 * Keeps size of a cache directory within a limit,
+	 * by removing least recently used files in a background thread
+	 */
+	class cache_evictor
+	{
+	public:
+		/**
+		 * Size of directory, and files removed
+		 */
+		struct stats
+		{
+			/**
+			 * Current size in bytes
+			 */
+			size_t size = 0;
+
+			/**
+			 * Current number of files
+			 */
+			size_t files = 0;
+
+			/**
+			 * Files removed since started
+			 */
+			size_t evicted_files = 0;
+
+			/**
+			 * Bytes removed since started
+			 */
+			size_t evicted_bytes = 0;
+		};
+
+		/**
+		 * @param directory Directory to limit size of
+		 * @param max_size Maximum size in bytes, or 0 for unlimited
+		 * @param interval How often to check size, or 0 to only check when calling evict
+		 */
+		cache_evictor(ghc::filesystem::path directory, size_t max_size,
+			std::chrono::milliseconds interval);
+
+		/**
+		 * Stops background thread
+		 */
+		~cache_evictor();
+
+		/**
+		 * Remove least recently used files until size is below limit
+		 */
+		auto evict() -> stats;
+
+		/**
+		 * Stats from last check
+		 */
+		auto get_stats() const -> stats;
+
+		/**
+		 * Maximum size in bytes, or 0 for unlimited
+		 */
+		auto get_max_size() const -> size_t;
+
+		/**
+		 * Set maximum size in bytes, or 0 for unlimited
+		 */
+		void set_max_size(size_t size);
+
+		/**
+		 * Mark file as recently used
+		 */
+		static void touch(const ghc::filesystem::path &path);
+
+	private:
+		/**
+		 * When removing files, remove until this percentage of limit is left,
+		 * to avoid evicting on every check
+		 */
+		static constexpr size_t low_watermark = 90;
+
+		ghc::filesystem::path directory;
+		std::chrono::milliseconds interval;
+
+		size_t max_size;
+		stats current_stats;
+
+		mutable std::mutex mutex;
+		std::condition_variable condition;
+		std::thread thread;
+		bool stopped = false;
+
+		void run();
+	};
+
+	void to_json(nlohmann::json &j, const cache_evictor::stats &stats);
+}
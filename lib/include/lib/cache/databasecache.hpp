@@ -0,0 +1,75 @@
+#pragma once
+
+#include "lib/cache/jsoncache.hpp"
+#include "lib/cache/recordstore.hpp"
+
+namespace lib
+{
+	/**
+	 * Cache stored in a single file, except album images,
+	 * which are stored as separate files
+	 */
+	class database_cache: public json_cache
+	{
+	public:
+		/**
+		 * Instance a new database cache manager, opens, or creates, cache file
+		 * @param paths Paths to get cache directory
+		 */
+		explicit database_cache(const lib::paths &paths);
+
+		auto get_album(const std::string &album_id) const -> lib::spt::album override;
+		void set_album(const spt::album &album) override;
+
+		auto get_playlists() const -> std::vector<lib::spt::playlist> override;
+		void set_playlists(const std::vector<spt::playlist> &playlists) override;
+
+		auto get_playlist(const std::string &playlist_id) const -> lib::spt::playlist override;
+		void set_playlist(const spt::playlist &playlist) override;
+
+		auto get_tracks(const std::string &entity_id) const -> std::vector<lib::spt::track> override;
+		void set_tracks(const std::string &entity_id,
+			const std::vector<lib::spt::track> &tracks) override;
+		auto all_tracks() const -> std::map<std::string, std::vector<lib::spt::track>> override;
+
+		auto get_track_info(const lib::spt::track &track) const -> lib::spt::track_info override;
+		void set_track_info(const lib::spt::track &track,
+			const lib::spt::track_info &track_info) override;
+
+		void add_crash(const lib::crash_info &info) override;
+		auto get_all_crashes() const -> std::vector<lib::crash_info> override;
+
+		/**
+		 * Write all pending changes to cache file
+		 */
+		void commit();
+
+	protected:
+		auto load_playlist_index() const -> lib::playlist_index override;
+		void save_playlist_index(const lib::playlist_index &index) override;
+
+	private:
+		/**
+		 * Number of changes to keep in memory before writing them to file
+		 */
+		static constexpr size_t max_pending = 32;
+
+		mutable record_store store;
+
+		/**
+		 * Get key for cache type and id
+		 */
+		static auto key(const std::string &type, const std::string &entity_id) -> std::string;
+
+		/**
+		 * Get JSON stored as CBOR
+		 * @return JSON, or null if not found or invalid
+		 */
+		auto get_json(const std::string &key) const -> nlohmann::json;
+
+		/**
+		 * Store JSON as CBOR
+		 */
+		void set_json(const std::string &key, const nlohmann::json &json);
+	};
+}
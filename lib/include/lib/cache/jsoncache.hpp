@@ -33,6 +33,7 @@ namespace lib
 
 		auto get_playlist(const std::string &playlist_id) const -> lib::spt::playlist override;
 		void set_playlist(const spt::playlist &playlist) override;
+		auto get_playlist_index() const -> const lib::playlist_index & override;
 
 		auto get_tracks(const std::string &entity_id) const -> std::vector<lib::spt::track> override;
 		void set_tracks(const std::string &entity_id,
@@ -46,7 +47,7 @@ namespace lib
 		void add_crash(const lib::crash_info &info) override;
 		auto get_all_crashes() const -> std::vector<lib::crash_info> override;
 
-	private:
+	protected:
 		const lib::paths &paths;
 
 		/**
@@ -65,6 +66,30 @@ namespace lib
 		auto path(const std::string &type, const std::string &entity_id,
 			const std::string &extension) const -> std::string;
 
+		/**
+		 * Update playlist in index, and save index
+		 */
+		void update_playlist_index(const spt::playlist &playlist);
+
+		/**
+		 * Load playlist index, creating it from cached playlists if needed
+		 */
+		virtual auto load_playlist_index() const -> lib::playlist_index;
+
+		/**
+		 * Save playlist index
+		 */
+		virtual void save_playlist_index(const lib::playlist_index &index);
+
+	private:
+		mutable lib::playlist_index cached_playlist_index;
+		mutable bool has_playlist_index = false;
+
+		/**
+		 * Get playlist index, loading it if needed
+		 */
+		auto playlist_index() const -> lib::playlist_index &;
+
 		/**
 		 * Get basename of path
 		 */
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace lib
+{
+	/**
+	 * Map with a maximum total size,
+	 * where the least recently used items are removed first when full
+	 */
+	template<typename T>
+	class lru_cache
+	{
+	public:
+		/**
+		 * @param max_size Maximum total size of all items
+		 */
+		explicit lru_cache(size_t max_size)
+			: max_size(max_size)
+		{
+		}
+
+		/**
+		 * Get item and mark it as most recently used
+		 * @return Item, or nullptr if not found, only valid until next change
+		 */
+		auto get(const std::string &key) -> const T *
+		{
+			const auto item = lookup.find(key);
+			if (item == lookup.end())
+			{
+				return nullptr;
+			}
+
+			entries.splice(entries.begin(), entries, item->second);
+			return &item->second->value;
+		}
+
+		/**
+		 * Add, or replace, item as most recently used,
+		 * items larger than maximum size are not added
+		 * @param size Size of item, in any unit, as long as it's the same for all items
+		 */
+		void put(const std::string &key, const T &value, size_t size)
+		{
+			remove(key);
+			if (size > max_size)
+			{
+				return;
+			}
+
+			entries.push_front(entry{key, value, size});
+			lookup[key] = entries.begin();
+			current_size += size;
+
+			while (current_size > max_size)
+			{
+				const auto last = entries.back().key;
+				remove(last);
+			}
+		}
+
+		void remove(const std::string &key)
+		{
+			const auto item = lookup.find(key);
+			if (item == lookup.end())
+			{
+				return;
+			}
+
+			current_size -= item->second->size;
+			entries.erase(item->second);
+			lookup.erase(item);
+		}
+
+		void clear()
+		{
+			entries.clear();
+			lookup.clear();
+			current_size = 0;
+		}
+
+		/**
+		 * Total size of all items
+		 */
+		auto size() const -> size_t
+		{
+			return current_size;
+		}
+
+	private:
+		using entry = struct entry
+		{
+			std::string key;
+			T value;
+			size_t size;
+		};
+
+		size_t max_size;
+		size_t current_size = 0;
+
+		std::list<entry> entries;
+		std::unordered_map<std::string, typename std::list<entry>::iterator> lookup;
+	};
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "lib/cache.hpp"
+#include "lib/cache/lrucache.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace lib
+{
+	/**
+	 * Keeps recently used items from another cache in memory,
+	 * and writes changes to it in batches in a background thread
+	 */
+	class memory_cache: public cache
+	{
+	public:
+		/**
+		 * @param cache Cache to read from, and write to
+		 * @param max_size Maximum weight of albums, playlists and track lists, each,
+		 * to keep in memory, where albums count 1 and track lists count their tracks + 1
+		 * @param write_delay Time to wait for more changes before writing
+		 */
+		memory_cache(std::unique_ptr<lib::cache> cache, size_t max_size,
+			std::chrono::milliseconds write_delay);
+
+		/**
+		 * Writes all pending changes
+		 */
+		~memory_cache() override;
+
+		auto get_album_image(const std::string &url) const -> std::vector<unsigned char> override;
+		auto get_album_image_path(const std::string &url) const -> std::string override;
+		void set_album_image(const std::string &url,
+			const std::vector<unsigned char> &data) override;
+
+		auto get_album(const std::string &album_id) const -> lib::spt::album override;
+		void set_album(const spt::album &album) override;
+
+		auto get_playlists() const -> std::vector<lib::spt::playlist> override;
+		void set_playlists(const std::vector<spt::playlist> &playlists) override;
+
+		auto get_playlist(const std::string &playlist_id) const -> lib::spt::playlist override;
+		void set_playlist(const spt::playlist &playlist) override;
+		auto get_playlist_index() const -> const lib::playlist_index & override;
+
+		auto get_tracks(const std::string &entity_id) const -> std::vector<lib::spt::track> override;
+		void set_tracks(const std::string &entity_id,
+			const std::vector<lib::spt::track> &tracks) override;
+		auto all_tracks() const -> std::map<std::string, std::vector<lib::spt::track>> override;
+
+		auto get_track_info(const lib::spt::track &track) const -> lib::spt::track_info override;
+		void set_track_info(const lib::spt::track &track,
+			const lib::spt::track_info &track_info) override;
+
+		void add_crash(const lib::crash_info &info) override;
+		auto get_all_crashes() const -> std::vector<lib::crash_info> override;
+
+		/**
+		 * Write all pending changes, and wait for them to finish
+		 */
+		void flush() const;
+
+		/**
+		 * Called after followed playlists are changed
+		 */
+		void on_playlists_changed(const std::function<void(
+			const std::vector<lib::spt::playlist> &playlists)> &listener);
+
+		/**
+		 * Called after a playlist is changed
+		 */
+		void on_playlist_changed(const std::function<void(
+			const lib::spt::playlist &playlist)> &listener);
+
+		/**
+		 * Called after tracks are changed
+		 */
+		void on_tracks_changed(const std::function<void(const std::string &entity_id,
+			const std::vector<lib::spt::track> &tracks)> &listener);
+
+	private:
+		using write_function = std::function<void(lib::cache &cache)>;
+
+		std::unique_ptr<lib::cache> cache;
+		std::chrono::milliseconds write_delay;
+
+		/**
+		 * Locked when accessing memory or pending changes
+		 */
+		mutable std::mutex mutex;
+
+		/**
+		 * Locked when accessing underlying cache, always locked before mutex,
+		 * only for a single change when writing in the background
+		 */
+		mutable std::mutex cache_mutex;
+
+		mutable lib::lru_cache<lib::spt::album> albums;
+		mutable lib::lru_cache<lib::spt::playlist> playlists;
+		mutable lib::lru_cache<std::vector<lib::spt::track>> tracks;
+
+		mutable std::vector<lib::spt::playlist> all_playlists;
+		mutable bool has_all_playlists = false;
+
+		mutable lib::playlist_index playlist_index;
+		mutable bool has_playlist_index = false;
+
+		/**
+		 * Pending changes by key, where a new change replaces the previous one
+		 */
+		mutable std::map<std::string, write_function> pending;
+
+		/**
+		 * Keys of changes taken from pending, that are still being written
+		 */
+		mutable std::set<std::string> writing;
+		mutable std::condition_variable written;
+
+		/**
+		 * Called from the thread making the change
+		 */
+		std::function<void(const std::vector<lib::spt::playlist> &)> playlists_listener;
+		std::function<void(const lib::spt::playlist &)> playlist_listener;
+		std::function<void(const std::string &,
+			const std::vector<lib::spt::track> &)> tracks_listener;
+
+		std::condition_variable condition;
+		std::thread thread;
+		bool stopping = false;
+
+		void run();
+
+		/**
+		 * Queue change to be written in the background
+		 */
+		void write(const std::string &key, const write_function &function);
+
+		/**
+		 * Write pending change now, if any, requires cache_mutex to be locked
+		 */
+		void write_now(const std::string &key) const;
+
+		/**
+		 * Wait for change to be written, if currently being written in the background,
+		 * requires cache_mutex to not be locked
+		 */
+		void wait_for_write(const std::string &key) const;
+
+		/**
+		 * Get item from memory, or from cache if not in memory
+		 */
+		template<typename T>
+		auto get(lib::lru_cache<T> &items, const std::string &key,
+			const std::function<T(const lib::cache &cache)> &load,
+			const std::function<size_t(const T &item)> &size) const -> T
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				const auto *item = items.get(key);
+				if (item != nullptr)
+				{
+					return *item;
+				}
+			}
+
+			wait_for_write(key);
+
+			std::lock_guard<std::mutex> cache_lock(cache_mutex);
+			write_now(key);
+			auto item = load(*cache);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			const auto *changed = items.get(key);
+			if (changed != nullptr)
+			{
+				// Changed while loading
+				return *changed;
+			}
+
+			items.put(key, item, size(item));
+			return item;
+		}
+	};
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "lib/json.hpp"
+#include "lib/spotify/playlist.hpp"
+
+#include "thirdparty/json.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Metadata of cached playlists, for queries without loading each playlist
+	 */
+	class playlist_index
+	{
+	public:
+		playlist_index() = default;
+
+		/**
+		 * Add, or replace, playlist in index
+		 */
+		void update(const lib::spt::playlist &playlist);
+
+		/**
+		 * When the most recent track was added to the playlist
+		 * @return Seconds since epoch, or 0 if unknown
+		 */
+		auto latest_added(const std::string &playlist_id) const -> long long;
+
+		/**
+		 * If any playlist has a track by artist
+		 * @param artist_name Name of artist
+		 */
+		auto has_artist(const std::string &artist_name) const -> bool;
+
+		/**
+		 * IDs of all playlists with a track by artist
+		 * @param artist_name Name of artist
+		 */
+		auto artist_playlists(const std::string &artist_name) const -> std::vector<std::string>;
+
+		/**
+		 * Number of playlists in index
+		 */
+		auto size() const -> size_t;
+
+		friend void to_json(nlohmann::json &j, const playlist_index &index);
+		friend void from_json(const nlohmann::json &j, playlist_index &index);
+
+	private:
+		std::unordered_map<std::string, long long> added;
+
+		/**
+		 * Names of artists in each playlist
+		 */
+		std::unordered_map<std::string, std::vector<std::string>> artists;
+
+		/**
+		 * IDs of playlists for each artist name, created from artists
+		 */
+		std::unordered_map<std::string, std::unordered_set<std::string>> playlists;
+
+		void set_artists(const std::string &playlist_id, const std::vector<std::string> &names);
+	};
+
+	void to_json(nlohmann::json &j, const playlist_index &index);
+
+	void from_json(const nlohmann::json &j, playlist_index &index);
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "thirdparty/filesystem.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Key-value store in a single append-only file,
+	 * with an in-memory index of where the latest value for each key is
+	 */
+	class record_store
+	{
+	public:
+		/**
+		 * Open, or create, store
+		 * @param path Path to store file
+		 * @param max_pending Maximum number of changes to keep before committing
+		 */
+		record_store(const ghc::filesystem::path &path, size_t max_pending);
+
+		/**
+		 * Commits any pending changes
+		 */
+		~record_store();
+
+		/**
+		 * Get value for key
+		 * @return Value, or empty if not found or invalid
+		 */
+		auto get(const std::string &key) const -> std::vector<unsigned char>;
+
+		/**
+		 * Set value for key, written on next commit
+		 */
+		void put(const std::string &key, const std::vector<unsigned char> &value);
+
+		/**
+		 * Get all keys starting with prefix, in order
+		 */
+		auto keys(const std::string &prefix) const -> std::vector<std::string>;
+
+		/**
+		 * Write all pending changes to file
+		 */
+		void commit();
+
+	private:
+		/**
+		 * Position of value in file
+		 */
+		using location = struct location
+		{
+			uint64_t offset;
+			uint32_t size;
+			uint32_t checksum;
+		};
+
+		/**
+		 * Size of record header, key size, value size and checksum
+		 */
+		static constexpr size_t header_size = 12;
+
+		ghc::filesystem::path path;
+		size_t max_pending;
+
+		mutable std::mutex mutex;
+		mutable std::fstream file;
+
+		std::map<std::string, location> index;
+		std::map<std::string, std::vector<unsigned char>> pending;
+
+		uint64_t file_size = 0;
+		uint64_t live_size = 0;
+
+		/**
+		 * Open file and build index from its records
+		 */
+		void open();
+
+		/**
+		 * Rewrite file with only the latest value of each key
+		 */
+		void compact();
+
+		/**
+		 * Write pending changes to file, requires mutex to be locked
+		 */
+		void write_pending();
+
+		/**
+		 * Read value at location, without verifying it
+		 */
+		auto read(const location &loc) const -> std::vector<unsigned char>;
+
+		static auto checksum(const std::string &key,
+			const std::vector<unsigned char> &value) -> uint32_t;
+
+		static auto record(const std::string &key,
+			const std::vector<unsigned char> &value) -> std::vector<unsigned char>;
+	};
+}
@@ -3,6 +3,7 @@
 #include <string>
 #include <iomanip>
 #include <sstream>
+#include <ctime>
 
 namespace lib
 {
@@ -34,6 +35,8 @@ namespace lib
 		 */
 		date_time(const date_time &date);
 
+		auto operator=(const date_time &date) -> date_time & = default;
+
 		/**
 		 * Try to parse a date from a string
 		 * @param value ISO date
@@ -47,6 +50,12 @@ namespace lib
 		 */
 		static auto now() -> date_time;
 
+		/**
+		 * Date and time in local time
+		 * @param time Seconds since 1970-01-01
+		 */
+		static auto local(std::time_t time) -> date_time;
+
 		/**
 		 * Current date and time in UTC to_string
 		 * @return Current UTC date
@@ -88,6 +97,12 @@ namespace lib
 		 */
 		auto to_iso_date_time() const -> std::string;
 
+		/**
+		 * Seconds since 1970-01-01, assuming date is in UTC
+		 * @return Seconds, or 0 if invalid
+		 */
+		auto to_epoch() const -> long long;
+
 		/**
 		 * Second, 0-60
 		 */
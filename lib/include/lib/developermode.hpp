@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 namespace lib
 {
 	/**
@@ -14,7 +16,7 @@ namespace lib
 		 * this can for example enable more verbose logging,
 		 * @note false by default
 		 */
-		static bool enabled;
+		static std::atomic<bool> enabled;
 
 	private:
 		/**
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace lib
+{
+	/**
+	 * Format to store cached data in
+	 */
+	enum class cache_type: char
+	{
+		/**
+		 * Everything as JSON files
+		 */
+		json = 0,
+
+		/**
+		 * Tracks as binary files, everything else as JSON files
+		 */
+		binary = 1,
+
+		/**
+		 * Everything except album images in a single file
+		 */
+		database = 2,
+	};
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace lib
+{
+	/**
+	 * Priority of HTTP requests, lowest value is sent first
+	 */
+	enum class request_priority: char
+	{
+		/**
+		 * Controlling playback, user is waiting for it
+		 */
+		playback = 0,
+
+		/**
+		 * Loading information, like tracks or playlists
+		 */
+		metadata = 1,
+
+		/**
+		 * Downloading images
+		 */
+		image = 2,
+	};
+}
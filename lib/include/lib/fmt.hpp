@@ -2,8 +2,11 @@
 
 #include "thirdparty/json.hpp"
 
+#include <array>
+#include <cstring>
 #include <string>
 #include <sstream>
+#include <type_traits>
 
 namespace lib
 {
@@ -13,79 +16,246 @@ namespace lib
 		template<typename Format, typename Arg, typename... Args>
 		static auto format(const Format &str, const Arg &arg, Args &&... args) -> std::string
 		{
-			std::stringstream stream;
+			return vformat(data(str), size(str), arg, args...);
+		}
+
+	private:
+		/**
+		 * Longest possible formatted 64-bit integer, including sign
+		 */
+		static constexpr size_t integer_size = 20;
+
+		/**
+		 * Estimated size of arguments that aren't strings
+		 */
+		static constexpr size_t default_size = 16;
+
+		/**
+		 * Format into a string reserved for the formatted result,
+		 * after finding all placeholders
+		 */
+		template<typename... Args>
+		static auto vformat(const char *str, size_t str_size, const Args &... args) -> std::string
+		{
+			constexpr size_t arg_count = sizeof...(Args);
+
+			std::array<size_t, arg_count> placeholders{};
+			size_t placeholder_count = 0;
+
+			for (size_t i = 0; placeholder_count < arg_count && i + 1 < str_size; i++)
+			{
+				if (str[i] == '{' && str[i + 1] == '}')
+				{
+					placeholders[placeholder_count++] = i;
+					i++;
+				}
+			}
+
+			std::string result;
+			result.reserve(str_size + size_hint(args...));
+
 			size_t index = 0;
+			replace(result, str, placeholders.data(), placeholder_count, index, args...);
 
-			vformat(std::string(str), stream, index, arg, args...);
-			return stream.str();
+			result.append(str + index, str_size - index);
+			return result;
+		}
+
+		/**
+		 * Replace with no arguments
+		 */
+		static void replace(std::string &/*result*/, const char */*str*/,
+			const size_t */*placeholders*/, size_t /*count*/, size_t &/*index*/)
+		{
 		}
 
-	private:
 		/**
-		 * Format with no arguments
+		 * Replace next placeholder with argument, ignoring arguments without a placeholder
 		 */
-		static void vformat(const std::string &str, std::stringstream &stream, size_t &index)
+		template<typename Arg, typename... Args>
+		static void replace(std::string &result, const char *str, const size_t *placeholders,
+			size_t count, size_t &index, const Arg &arg, const Args &... args)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			result.append(str + index, *placeholders - index);
+			append(result, arg);
+			index = *placeholders + 2;
+
+			replace(result, str, placeholders + 1, count - 1, index, args...);
+		}
+
+		/**
+		 * Format string data
+		 */
+		static auto data(const std::string &str) -> const char *
+		{
+			return str.data();
+		}
+
+		static auto data(const char *str) -> const char *
+		{
+			return str;
+		}
+
+		/**
+		 * Format string size
+		 */
+		static auto size(const std::string &str) -> size_t
+		{
+			return str.size();
+		}
+
+		static auto size(const char *str) -> size_t
 		{
-			stream << str.substr(index);
+			return std::strlen(str);
 		}
 
 		/**
-		 * Format with multiple arguments
+		 * Estimated size of all formatted arguments
 		 */
+		static auto size_hint() -> size_t
+		{
+			return 0;
+		}
+
 		template<typename Arg, typename... Args>
-		static void vformat(const std::string &str, std::stringstream &stream, size_t &index,
-			const Arg &arg, Args &&... args)
+		static auto size_hint(const Arg &arg, const Args &... args) -> size_t
+		{
+			return arg_size(arg) + size_hint(args...);
+		}
+
+		template<typename Arg>
+		static auto arg_size(const Arg &/*arg*/) -> size_t
+		{
+			return default_size;
+		}
+
+		static auto arg_size(const std::string &arg) -> size_t
+		{
+			return arg.size();
+		}
+
+		static auto arg_size(const char *arg) -> size_t
+		{
+			return arg == nullptr ? 0 : std::strlen(arg);
+		}
+
+		/**
+		 * Integer, but not bool or any char type, which are formatted differently
+		 */
+		template<typename Arg>
+		struct is_integer: std::integral_constant<bool, std::is_integral<Arg>::value
+			&& !std::is_same<Arg, bool>::value
+			&& !std::is_same<Arg, char>::value
+			&& !std::is_same<Arg, signed char>::value
+			&& !std::is_same<Arg, unsigned char>::value
+			&& !std::is_same<Arg, wchar_t>::value
+			&& !std::is_same<Arg, char16_t>::value
+			&& !std::is_same<Arg, char32_t>::value>
+		{
+		};
+
+		/**
+		 * Generic formatter
+		 */
+		template<typename Arg>
+		static void append(std::string &result, const Arg &arg)
 		{
-			replace(str, stream, index, arg);
-			vformat(str, stream, index, args...);
+			append(result, arg, is_integer<Arg>());
 		}
 
 		/**
-		 * Format with single argument
+		 * Format integer, without going through a stream
 		 */
 		template<typename Arg>
-		static void replace(const std::string &str, std::stringstream &stream,
-			size_t &index, const Arg &arg)
+		static void append(std::string &result, const Arg &arg, std::true_type /*integer*/)
 		{
-			const auto next = str.find("{}", index);
+			using unsigned_arg = typename std::make_unsigned<Arg>::type;
+
+			std::array<char, integer_size> buffer;
+			auto *end = buffer.data() + buffer.size();
+			auto *begin = end;
 
-			if (next == std::string::npos)
+			const auto negative = is_negative(arg, std::is_signed<Arg>());
+			// Negate as unsigned, as the lowest value can't be negated as signed
+			auto value = negative
+				? static_cast<unsigned_arg>(0U - static_cast<unsigned_arg>(arg))
+				: static_cast<unsigned_arg>(arg);
+
+			do
 			{
-				stream << str.substr(index);
-				index = str.size();
-				return;
+				*--begin = static_cast<char>('0' + value % 10U);
+				value /= 10U;
+			}
+			while (value > 0);
+
+			if (negative)
+			{
+				*--begin = '-';
 			}
 
-			stream
-				<< str.substr(index, next - index)
-				<< to_string(arg);
+			result.append(begin, end);
+		}
+
+		template<typename Arg>
+		static auto is_negative(const Arg &arg, std::true_type /*is_signed*/) -> bool
+		{
+			return arg < 0;
+		}
 
-			index = next + 2;
+		template<typename Arg>
+		static auto is_negative(const Arg &/*arg*/, std::false_type /*is_signed*/) -> bool
+		{
+			return false;
 		}
 
 		/**
-		 * Generic formatter
+		 * Format anything else supported by streams
 		 */
 		template<typename Arg>
-		static auto to_string(const Arg &arg) -> const Arg &
+		static void append(std::string &result, const Arg &arg, std::false_type /*integer*/)
+		{
+			std::ostringstream stream;
+			stream << arg;
+			result.append(stream.str());
+		}
+
+		static void append(std::string &result, const std::string &arg)
+		{
+			result.append(arg);
+		}
+
+		static void append(std::string &result, const char *arg)
+		{
+			if (arg != nullptr)
+			{
+				result.append(arg);
+			}
+		}
+
+		static void append(std::string &result, char arg)
 		{
-			return arg;
+			result.push_back(arg);
 		}
 
 		/**
 		 * Format bool as "true" or "false"
 		 */
-		static auto to_string(const bool arg) -> const char *
+		static void append(std::string &result, const bool arg)
 		{
-			return arg ? "true" : "false";
+			result.append(arg ? "true" : "false");
 		}
 
 		/**
 		 * Format json by dumping content
 		 */
-		static auto to_string(const nlohmann::json &json) -> std::string
+		static void append(std::string &result, const nlohmann::json &json)
 		{
-			return json.dump();
+			result.append(json.dump());
 		}
 	};
 }
@@ -20,7 +20,7 @@ namespace lib
 		 * Format size as B, kB, MB or GB (bytes)
 		 * @param bytes Bytes
 		 */
-		static auto size(unsigned int bytes) -> std::string;
+		static auto size(size_t bytes) -> std::string;
 
 		/**
 		 * Format as k or M
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "lib/httpclient.hpp"
+#include "lib/cache/lrucache.hpp"
+#include "thirdparty/json.hpp"
+
+#include <chrono>
+#include <string>
+
+namespace lib
+{
+	/**
+	 * Parsed responses to GET requests, with ETag and Cache-Control metadata,
+	 * for sending conditional requests
+	 */
+	class http_cache
+	{
+	public:
+		/**
+		 * Number of requests by result
+		 */
+		struct stats
+		{
+			/**
+			 * Still fresh, no request needed
+			 */
+			size_t fresh = 0;
+
+			/**
+			 * Not modified since cached
+			 */
+			size_t revalidated = 0;
+
+			/**
+			 * Full response received
+			 */
+			size_t misses = 0;
+
+			/**
+			 * Size of response bodies not downloaded
+			 */
+			size_t saved_bytes = 0;
+		};
+
+		/**
+		 * @param max_size Maximum total size of cached response bodies, in bytes
+		 */
+		explicit http_cache(size_t max_size);
+
+		/**
+		 * Get cached response if it can be used without sending a request
+		 * @param url Full URL
+		 * @param json Cached response, if fresh
+		 * @return Response is fresh
+		 */
+		auto get_fresh(const std::string &url, nlohmann::json &json) -> bool;
+
+		/**
+		 * Add headers to make request conditional, if response is cached
+		 */
+		void add_headers(const std::string &url, lib::headers &headers);
+
+		/**
+		 * Get cached response, if server responded that it's not modified
+		 * @param response Response from server
+		 * @param json Cached response, if not modified
+		 * @return Cached response can be used
+		 */
+		auto get_not_modified(const std::string &url, const lib::http_response &response,
+			nlohmann::json &json) -> bool;
+
+		/**
+		 * Save parsed response, if successful and allowed by response headers
+		 */
+		void set(const std::string &url, const lib::http_response &response,
+			const nlohmann::json &json);
+
+		/**
+		 * Require all cached responses to be revalidated,
+		 * for example, after something was changed
+		 */
+		void expire();
+
+		/**
+		 * Remove cached response
+		 */
+		void remove(const std::string &url);
+
+		void clear();
+
+		auto get_stats() const -> const stats &;
+
+	private:
+		using clock = std::chrono::steady_clock;
+
+		struct entry
+		{
+			std::string etag;
+			clock::time_point expires;
+			size_t generation;
+			size_t size;
+			nlohmann::json json;
+		};
+
+		lib::lru_cache<entry> entries;
+
+		/**
+		 * Incremented when all entries expire
+		 */
+		size_t generation = 0;
+
+		stats current_stats;
+
+		/**
+		 * Seconds response can be used without revalidating, or -1 if it shouldn't be stored
+		 */
+		static auto max_age(const lib::headers &headers) -> int;
+
+		static auto header(const lib::headers &headers, const std::string &name) -> std::string;
+	};
+
+	void to_json(nlohmann::json &j, const http_cache::stats &stats);
+}
@@ -13,6 +13,27 @@ namespace lib
 	 */
 	using headers = std::map<std::string, std::string>;
 
+	/**
+	 * Response to a request
+	 */
+	struct http_response
+	{
+		/**
+		 * HTTP status code, or 0 if no response
+		 */
+		int status = 0;
+
+		/**
+		 * Response headers, with names in lowercase
+		 */
+		lib::headers headers;
+
+		/**
+		 * Response body
+		 */
+		std::string body;
+	};
+
 	/**
 	 * Abstract HTTP client
 	 */
@@ -25,6 +46,13 @@ namespace lib
 		virtual void get(const std::string &url, const headers &headers,
 			lib::callback<std::string> &callback) const = 0;
 
+		/**
+		 * GET request, with status and headers of response
+		 * @note Default implementation only provides body, with status 200
+		 */
+		virtual void get_response(const std::string &url, const headers &headers,
+			lib::callback<http_response> &callback) const;
+
 		/**
 		 * PUT request
 		 * @param body JSON body, or empty if none
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "lib/cache.hpp"
+#include "lib/httpclient.hpp"
+#include "thirdparty/json.hpp"
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Loads images from cache, or downloads them, only requesting each image once
+	 * even if requested multiple times while downloading
+	 */
+	class image_loader
+	{
+	public:
+		/**
+		 * Number of requested images by result
+		 */
+		struct stats
+		{
+			/**
+			 * Loaded from cache
+			 */
+			size_t hits = 0;
+
+			/**
+			 * Downloaded
+			 */
+			size_t misses = 0;
+
+			/**
+			 * Already being downloaded when requested
+			 */
+			size_t deduplicated = 0;
+
+			/**
+			 * Failed to download
+			 */
+			size_t failed = 0;
+		};
+
+		/**
+		 * @param http_client HTTP client to download images with
+		 * @param cache Cache to load images from, and save downloaded images to
+		 * @param max_requests_per_host Maximum number of downloads from the same host at once
+		 */
+		image_loader(const lib::http_client &http_client, lib::cache &cache,
+			size_t max_requests_per_host);
+
+		/**
+		 * Get image from cache, or download it
+		 * @param url URL to image
+		 * @param callback Image data, or empty if not a valid image
+		 */
+		void get(const std::string &url, lib::callback<std::vector<unsigned char>> &callback);
+
+		/**
+		 * Image is already cached
+		 */
+		auto is_cached(const std::string &url) const -> bool;
+
+		auto get_stats() const -> const stats &;
+
+	private:
+		const lib::http_client &http_client;
+		lib::cache &cache;
+		size_t max_requests_per_host;
+
+		stats current_stats;
+
+		/**
+		 * Callbacks waiting for each image to be downloaded
+		 */
+		std::unordered_map<std::string,
+			std::vector<std::function<void(const std::vector<unsigned char> &)>>> pending;
+
+		/**
+		 * Number of active downloads, and URLs waiting to be downloaded, by host
+		 */
+		std::unordered_map<std::string, size_t> active;
+		std::unordered_map<std::string, std::deque<std::string>> queued;
+
+		void download(const std::string &url);
+		void downloaded(const std::string &url, const std::string &data);
+
+		static auto host(const std::string &url) -> std::string;
+	};
+
+	void to_json(nlohmann::json &j, const image_loader::stats &stats);
+}
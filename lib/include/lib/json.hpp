@@ -2,11 +2,16 @@
 
 #include "lib/log.hpp"
 #include "lib/optional.hpp"
+#include "lib/writequeue.hpp"
 
 #include "thirdparty/json.hpp"
 #include "thirdparty/filesystem.hpp"
 
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace lib
 {
@@ -63,7 +68,8 @@ namespace lib
 		}
 
 		/**
-		 * Load and parse JSON from file
+		 * Load and parse JSON from file,
+		 * or from memory if still saving in the background
 		 * @param path Path to json file, including extension
 		 * @return JSON object, or null object on failure
 		 */
@@ -85,12 +91,36 @@ namespace lib
 		}
 
 		/**
-		 * Save specified item to a json file
+		 * Save specified item to a json file in the background
 		 * @param path Path to json file, including extension
 		 * @param item Item to save
 		 */
 		static void save(const ghc::filesystem::path &path, const nlohmann::json &json);
 
+		/**
+		 * Save specified item to a json file in the background, without copying it
+		 */
+		static void save(const ghc::filesystem::path &path, nlohmann::json &&json);
+
+		/**
+		 * Remove json file in the background, including if still saving
+		 * @param path Path to json file, including extension
+		 */
+		static void remove(const ghc::filesystem::path &path);
+
+		/**
+		 * Wait for all saves in the background to finish
+		 */
+		static void flush();
+
+		/**
+		 * Files in directory, including files still saving in the background
+		 * @param directory Directory to list files in
+		 * @return Paths to files, excluding temporary files
+		 */
+		static auto list(const ghc::filesystem::path &directory)
+		-> std::vector<ghc::filesystem::path>;
+
 		/**
 		 * Find the last value in an "item"s array, or from "item" directly
 		 * @param name Name of item to search for, excluding s-suffix
@@ -112,5 +142,20 @@ namespace lib
 
 	private:
 		json() = default;
+
+		/**
+		 * Items still saving in the background, by path,
+		 * or empty if still removing
+		 */
+		struct pending_items
+		{
+			std::mutex mutex;
+			std::map<std::string, std::shared_ptr<const nlohmann::json>> items;
+		};
+
+		/**
+		 * Shared, so it's kept until all saves have finished
+		 */
+		static auto pending() -> const std::shared_ptr<pending_items> &;
 	};
 }
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "thirdparty/json.hpp"
+
+#include <array>
+#include <chrono>
+
+namespace lib
+{
+	/**
+	 * Distribution of request latencies
+	 */
+	class latency_histogram
+	{
+	public:
+		/**
+		 * Milliseconds
+		 */
+		using ms = std::chrono::milliseconds;
+
+		/**
+		 * Number of buckets, including the last, unbounded, one
+		 */
+		static constexpr size_t bucket_count = 7;
+
+		/**
+		 * Record a new latency
+		 */
+		void add(ms latency);
+
+		/**
+		 * Number of recorded latencies
+		 */
+		auto count() const -> size_t;
+
+		/**
+		 * Average latency, or 0 if none
+		 */
+		auto mean() const -> ms;
+
+		/**
+		 * Highest recorded latency
+		 */
+		auto max() const -> ms;
+
+		/**
+		 * Number of latencies in bucket
+		 * @param index Bucket index, less than bucket_count
+		 */
+		auto bucket(size_t index) const -> size_t;
+
+		/**
+		 * Upper, exclusive, bound of bucket, or 0 for the last bucket
+		 */
+		static auto upper_bound(size_t index) -> ms;
+
+	private:
+		std::array<size_t, bucket_count> buckets{};
+		size_t total_count = 0;
+		ms total = ms(0);
+		ms highest = ms(0);
+	};
+
+	void to_json(nlohmann::json &j, const latency_histogram &histogram);
+}
@@ -3,8 +3,11 @@
 #include "lib/enum/logtype.hpp"
 #include "lib/fmt.hpp"
 #include "lib/logmessage.hpp"
+#include "lib/logqueue.hpp"
+#include "lib/logstore.hpp"
 #include "lib/developermode.hpp"
 
+#include <atomic>
 #include <iostream>
 #include <regex>
 
@@ -22,7 +25,10 @@ namespace lib
 		template<typename Format, typename Arg, typename... Args>
 		static void info(const Format &fmt, const Arg &arg, Args &&... args)
 		{
-			info(fmt::format(fmt, arg, args...));
+			if (is_enabled(log_type::information))
+			{
+				message(log_type::information, fmt::format(fmt, arg, args...));
+			}
 		}
 
 		/**
@@ -31,7 +37,10 @@ namespace lib
 		template<typename Format>
 		static void info(const Format &fmt)
 		{
-			message(log_type::information, fmt);
+			if (is_enabled(log_type::information))
+			{
+				message(log_type::information, fmt);
+			}
 		}
 
 		/**
@@ -40,7 +49,10 @@ namespace lib
 		template<typename Format, typename Arg, typename... Args>
 		static void warn(const Format &fmt, const Arg &arg, Args &&... args)
 		{
-			warn(fmt::format(fmt, arg, args...));
+			if (is_enabled(log_type::warning))
+			{
+				message(log_type::warning, fmt::format(fmt, arg, args...));
+			}
 		}
 
 		/**
@@ -49,7 +61,10 @@ namespace lib
 		template<typename Format>
 		static void warn(const Format &fmt)
 		{
-			message(log_type::warning, fmt);
+			if (is_enabled(log_type::warning))
+			{
+				message(log_type::warning, fmt);
+			}
 		}
 
 		/***
@@ -58,7 +73,10 @@ namespace lib
 		template<typename Format, typename Arg, typename... Args>
 		static void error(const Format &fmt, const Arg &arg, Args &&... args)
 		{
-			error(fmt::format(fmt, arg, args...));
+			if (is_enabled(log_type::error))
+			{
+				message(log_type::error, fmt::format(fmt, arg, args...));
+			}
 		}
 
 		/**
@@ -67,7 +85,10 @@ namespace lib
 		template<typename Format>
 		static void error(const Format &fmt)
 		{
-			message(log_type::error, fmt);
+			if (is_enabled(log_type::error))
+			{
+				message(log_type::error, fmt);
+			}
 		}
 
 		/**
@@ -77,7 +98,10 @@ namespace lib
 		template<typename Format, typename Arg, typename... Args>
 		static void debug(const Format &fmt, const Arg &arg, Args &&... args)
 		{
-			debug(fmt::format(fmt, arg, args...));
+			if (is_enabled(log_type::verbose))
+			{
+				message(log_type::verbose, fmt::format(fmt, arg, args...));
+			}
 		}
 
 		/**
@@ -87,19 +111,46 @@ namespace lib
 		template<typename Format>
 		static void debug(const Format &fmt)
 		{
-			if (!developer_mode::enabled)
+			if (is_enabled(log_type::verbose))
+			{
+				message(log_type::verbose, fmt);
+			}
+		}
+
+		/**
+		 * If messages of type are logged, checked before formatting the message
+		 * @note Verbose messages also need developer_mode to be enabled
+		 */
+		static auto is_enabled(log_type type) -> bool
+		{
+			if (type == log_type::verbose && !developer_mode::enabled)
 			{
-				return;
+				return false;
 			}
 
-			message(log_type::verbose, fmt);
+			return (enabled_types.load(std::memory_order_relaxed) & flag(type)) != 0;
 		}
 
 		/**
-		 * Get all messages that has been logged since application start
+		 * Enable or disable logging messages of type, all types are enabled by default
+		 */
+		static void set_enabled(log_type type, bool value);
+
+		/**
+		 * Number of messages kept of each type
+		 */
+		static constexpr size_t capacity = 1000;
+
+		/**
+		 * Get all kept messages
 		 * @return Log messages
 		 */
-		static auto get_messages() -> const std::vector<log_message> &;
+		static auto get_messages() -> std::vector<log_message>;
+
+		/**
+		 * Store with all kept messages
+		 */
+		static auto get_store() -> log_store &;
 
 		/**
 		 * Clears all messages in the log
@@ -119,20 +170,40 @@ namespace lib
 		log() = default;
 
 		/**
-		 * History of all messages
+		 * Most recent messages
 		 */
-		static std::vector<log_message> messages;
+		static log_store messages;
+
+		/**
+		 * Messages waiting to be kept and printed
+		 */
+		static log_queue queue;
 
 		/**
 		 * Also print to stdout/stderr
 		 */
-		static bool log_to_stdout;
+		static std::atomic<bool> log_to_stdout;
+
+		/**
+		 * Types of messages to log, as flags
+		 */
+		static std::atomic<unsigned int> enabled_types;
+
+		static constexpr auto flag(log_type type) -> unsigned int
+		{
+			return 1U << static_cast<unsigned int>(type);
+		}
 
 		/**
 		 * Log a message with the specified type
 		 * @param logType Type of log
 		 * @param message Message to log
 		 */
-		static void message(log_type log_type, const std::string &message);
+		static void message(log_type log_type, std::string message);
+
+		/**
+		 * Keep and print message, called from queue
+		 */
+		static void write(const log_message &message);
 	};
 }
@@ -56,6 +56,11 @@ namespace lib
 		 */
 		auto get_type() const -> std::string;
 
+		/**
+		 * Get type of log
+		 */
+		auto get_log_type() const -> log_type;
+
 		/**
 		 * Get logged message
 		 * @return Message
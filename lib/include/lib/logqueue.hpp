@@ -0,0 +1,85 @@
+#pragma once
+
+#include "lib/enum/logtype.hpp"
+#include "lib/logmessage.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Passes log messages from any thread to a single background thread,
+	 * so logging only needs to briefly lock to add the message
+	 */
+	class log_queue
+	{
+	public:
+		/**
+		 * Writes a message, called from background thread, in the order messages were added
+		 */
+		using writer = std::function<void(const log_message &message)>;
+
+		explicit log_queue(writer write);
+
+		/**
+		 * Writes all pending messages
+		 */
+		~log_queue();
+
+		/**
+		 * Add message to write
+		 * @param log_type Type of log
+		 * @param message Message logged
+		 */
+		void push(log_type log_type, std::string message);
+
+		/**
+		 * Wait for all added messages to be written
+		 */
+		void flush();
+
+	private:
+		using clock = std::chrono::system_clock;
+
+		struct entry
+		{
+			clock::time_point time;
+			log_type type;
+			std::string message;
+		};
+
+		writer write;
+
+		std::vector<entry> pending;
+		std::vector<entry> writing;
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::condition_variable written;
+		bool stopped = false;
+
+		/**
+		 * Last converted time, only used from background thread
+		 */
+		std::time_t last_second = 0;
+		date_time last_time;
+
+		/**
+		 * Declared last, as it's started before the constructor body
+		 */
+		std::thread thread;
+
+		/**
+		 * Convert to local time, only converting once per second
+		 */
+		auto local_time(const clock::time_point &time) -> const date_time &;
+
+		void run();
+	};
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "lib/logmessage.hpp"
+#include "thirdparty/filesystem.hpp"
+
+#include <array>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Most recent log messages, with a fixed number kept for each type,
+	 * optionally moving older messages to rotating files
+	 */
+	class log_store
+	{
+	public:
+		static constexpr size_t type_count = 4;
+
+		struct entry
+		{
+			size_t sequence;
+			log_message message;
+		};
+
+		/**
+		 * State of store when reading entries
+		 */
+		struct read_result
+		{
+			/**
+			 * Cursor to pass to next read
+			 */
+			size_t cursor;
+
+			/**
+			 * Sequence of oldest entry still kept of each type
+			 */
+			std::array<size_t, type_count> oldest;
+
+			/**
+			 * Entry with sequence and type is still kept in store
+			 */
+			auto is_kept(size_t sequence, log_type type) const -> bool;
+		};
+
+		/**
+		 * @param capacity Maximum number of messages kept of each type
+		 */
+		explicit log_store(size_t capacity);
+
+		/**
+		 * Set maximum number of messages kept of type,
+		 * removing the oldest messages if more are kept
+		 */
+		void set_capacity(log_type type, size_t capacity);
+
+		/**
+		 * Append removed messages to file
+		 * @param path Path to file, older files get the same name, but ending with .1, .2, etc.
+		 * @param max_size Maximum size of file in bytes before it's rotated
+		 * @param max_files Maximum number of files, including the current one
+		 */
+		void set_spill(const ghc::filesystem::path &path, size_t max_size, size_t max_files);
+
+		/**
+		 * Add message, removing the oldest message of the same type if full
+		 */
+		void add(const log_message &message);
+
+		/**
+		 * Get messages added since last read
+		 * @param cursor Returned from previous read, or 0 to get all messages
+		 * @param messages Messages are appended, oldest first
+		 * @return Cursor to pass to next read
+		 */
+		auto read(size_t cursor, std::vector<log_message> &messages) const -> size_t;
+
+		/**
+		 * Get entries added since last read, and which older entries are still kept
+		 * @param cursor Returned from previous read, or 0 to get all entries
+		 * @param entries Entries are appended, oldest first
+		 */
+		auto read(size_t cursor, std::vector<entry> &entries) const -> read_result;
+
+		/**
+		 * Get all messages, oldest first
+		 */
+		auto get_messages() const -> std::vector<log_message>;
+
+		/**
+		 * Number of messages currently kept
+		 */
+		auto size() const -> size_t;
+
+		/**
+		 * Remove all messages, without spilling them
+		 */
+		void clear();
+
+	private:
+		/**
+		 * Fixed size buffer, overwriting the oldest entry when full
+		 */
+		struct ring
+		{
+			std::vector<entry> entries;
+			size_t capacity = 0;
+			size_t start = 0;
+		};
+
+		std::array<ring, type_count> rings;
+
+		/**
+		 * Sequence of next added message
+		 */
+		size_t next_sequence = 1;
+
+		ghc::filesystem::path spill_path;
+		size_t spill_max_size = 0;
+		size_t spill_max_files = 0;
+		std::ofstream spill_file;
+		size_t spill_size = 0;
+
+		mutable std::mutex mutex;
+
+		static auto index(log_type type) -> size_t;
+
+		void spill(const log_message &message);
+		void rotate();
+	};
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "lib/enum/requestpriority.hpp"
+#include "lib/latencyhistogram.hpp"
+#include "thirdparty/json.hpp"
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace lib
+{
+	/**
+	 * Limits number of requests sent to the same host at once,
+	 * sending queued requests with higher priority first
+	 */
+	class request_scheduler
+	{
+	public:
+		/**
+		 * Sends a request, and calls the provided function once it's finished
+		 */
+		using starter = std::function<void(const std::function<void()> &finished)>;
+
+		/**
+		 * Number of priority classes
+		 */
+		static constexpr size_t priority_count = 3;
+
+		/**
+		 * @param max_requests_per_host Maximum number of requests to the same host at once
+		 */
+		explicit request_scheduler(size_t max_requests_per_host);
+
+		/**
+		 * Send request now if possible, or queue it until there is room
+		 * @param url URL of request, used to get host
+		 * @param priority Requests with higher priority are sent first
+		 * @param start Sends the request
+		 */
+		void schedule(const std::string &url, lib::request_priority priority,
+			const starter &start);
+
+		/**
+		 * Requests to host are multiplexed over a single connection, like with HTTP/2,
+		 * so more requests can be sent at once
+		 * @param url URL of request sent to host
+		 */
+		void set_multiplexed(const std::string &url);
+
+		/**
+		 * Guess priority of request from URL
+		 */
+		static auto priority(const std::string &url) -> lib::request_priority;
+
+		/**
+		 * Time from request being scheduled, until finished
+		 */
+		auto latency(lib::request_priority priority) const -> const lib::latency_histogram &;
+
+		/**
+		 * Number of requests currently sent to host
+		 */
+		auto active(const std::string &host) const -> size_t;
+
+		/**
+		 * Number of requests waiting to be sent to host
+		 */
+		auto queued(const std::string &host) const -> size_t;
+
+	private:
+		using clock = std::chrono::steady_clock;
+
+		struct request
+		{
+			starter start;
+			lib::request_priority priority;
+			clock::time_point scheduled;
+		};
+
+		/**
+		 * Same as the default limit of concurrent streams in Qt
+		 */
+		static constexpr size_t max_multiplexed_requests = 100;
+
+		size_t max_requests_per_host;
+		std::unordered_set<std::string> multiplexed_hosts;
+
+		std::unordered_map<std::string, size_t> active_requests;
+		std::unordered_map<std::string,
+			std::array<std::deque<request>, priority_count>> queued_requests;
+
+		std::array<lib::latency_histogram, priority_count> histograms;
+
+		void start(const std::string &host, const request &request);
+		void finished(const std::string &host, const request &request);
+
+		/**
+		 * Start next queued request to host, if any
+		 * @return Request was started
+		 */
+		auto start_next(const std::string &host) -> bool;
+
+		/**
+		 * Maximum number of requests to host at once
+		 */
+		auto max_requests(const std::string &host) const -> size_t;
+
+		static auto host(const std::string &url) -> std::string;
+	};
+
+	void to_json(nlohmann::json &j, const request_scheduler &scheduler);
+}
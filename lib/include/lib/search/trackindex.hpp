@@ -0,0 +1,113 @@
+#pragma once
+
+#include "lib/spotify/track.hpp"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lib
+{
+	/**
+	 * Full-text index of tracks from multiple sources, like playlists,
+	 * searchable by words in track, album, and artist names
+	 */
+	class track_index
+	{
+	public:
+		track_index() = default;
+
+		/**
+		 * Set all tracks in a source, replacing any previous tracks from it
+		 * @param source_id ID of source, for example, playlist ID
+		 * @return If any tracks were changed
+		 */
+		auto set_tracks(const std::string &source_id,
+			const std::vector<lib::spt::track> &tracks) -> bool;
+
+		/**
+		 * Remove all tracks in a source
+		 */
+		void remove_source(const std::string &source_id);
+
+		/**
+		 * Source has been added
+		 */
+		auto has_source(const std::string &source_id) const -> bool;
+
+		/**
+		 * Find tracks where each word in the query is the start of, or for words
+		 * of at least three characters, part of, a word in any name of the track
+		 * @return Matching tracks, in the order they were added
+		 */
+		auto search(const std::string &query) const -> std::vector<lib::spt::track>;
+
+		/**
+		 * Number of unique tracks
+		 */
+		auto size() const -> size_t;
+
+		/**
+		 * Split text into lowercase words, ignoring ASCII symbols and whitespace
+		 */
+		static auto tokenize(const std::string &text) -> std::vector<std::string>;
+
+	private:
+		using doc_id = uint32_t;
+
+		using document = struct document
+		{
+			lib::spt::track track;
+			size_t references;
+
+			/**
+			 * Order document was added in, as IDs are reused
+			 */
+			uint64_t sequence;
+		};
+
+		std::vector<document> documents;
+		std::vector<doc_id> free_documents;
+		uint64_t next_sequence = 0;
+
+		/**
+		 * Document for each track key
+		 */
+		std::unordered_map<std::string, doc_id> document_ids;
+
+		/**
+		 * Documents, and hash of tracks, in each source
+		 */
+		std::unordered_map<std::string, std::vector<doc_id>> sources;
+		std::unordered_map<std::string, size_t> source_hashes;
+
+		/**
+		 * Sorted documents containing each word, sorted for prefix lookups
+		 */
+		std::map<std::string, std::vector<doc_id>> terms;
+
+		/**
+		 * Words containing each sequence of three characters
+		 */
+		std::unordered_map<std::string, std::set<std::string>> trigrams;
+
+		auto add_document(const lib::spt::track &track) -> doc_id;
+		void release_document(doc_id id);
+
+		void add_postings(doc_id id);
+		void remove_postings(doc_id id);
+
+		/**
+		 * All documents with a word matching a single query word
+		 */
+		auto match(const std::string &word) const -> std::vector<doc_id>;
+
+		static auto key(const lib::spt::track &track) -> std::string;
+		static auto hash(const std::vector<lib::spt::track> &tracks) -> size_t;
+		static auto track_terms(const lib::spt::track &track) -> std::set<std::string>;
+		static auto word_trigrams(const std::string &word) -> std::vector<std::string>;
+	};
+}
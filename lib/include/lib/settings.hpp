@@ -13,7 +13,9 @@
 #include "settings/qt.hpp"
 #include "lib/json.hpp"
 
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 
 namespace lib
 {
@@ -28,6 +30,11 @@ namespace lib
 		 */
 		explicit settings(const paths &paths);
 
+		/**
+		 * Saves pending changes
+		 */
+		~settings();
+
 		/**
 		 * Format settings in settings
 		 * @return JSON
@@ -41,10 +48,16 @@ namespace lib
 		void from_json(const nlohmann::json &json);
 
 		/**
-		 * Save settings to file
+		 * Save settings to file in the background,
+		 * once no more changes are saved for a while
 		 */
 		void save();
 
+		/**
+		 * Save pending changes to file now
+		 */
+		void flush();
+
 		/**
 		 * Load settings from file
 		 */
@@ -116,6 +129,28 @@ namespace lib
 		 */
 		std::mutex mutex;
 
+		/**
+		 * Mutex for making sure only latest settings are written to file
+		 */
+		std::mutex write_mutex;
+
+		/**
+		 * Settings waiting to be written to file
+		 */
+		nlohmann::json pending;
+
+		/**
+		 * Number of times saved, to know when to stop waiting for more changes
+		 */
+		unsigned int saves = 0;
+
+		std::condition_variable condition;
+		std::thread thread;
+		bool stopped = false;
+
+		void run();
+		void write();
+
 		/**
 		 * Qt settings
 		 */
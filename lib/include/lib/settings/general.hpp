@@ -1,6 +1,7 @@
 #pragma once
 
 #include "lib/json.hpp"
+#include "lib/enum/cachetype.hpp"
 #include "lib/enum/palette.hpp"
 #include "lib/enum/playlistorder.hpp"
 #include "lib/enum/spotifycontext.hpp"
@@ -29,6 +30,16 @@ namespace lib
 			 */
 			lib::playlist_order playlist_order = lib::playlist_order::none;
 
+			/**
+			 * Format to store cache in
+			 */
+			lib::cache_type cache_type = lib::cache_type::json;
+
+			/**
+			 * Maximum size of album cover cache in megabytes, or 0 for unlimited
+			 */
+			int album_cache_size = 250;
+
 			/**
 			 * Last viewed playlist
 			 */
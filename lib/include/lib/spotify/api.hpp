@@ -19,7 +19,10 @@
 #include "lib/spotify/savedalbum.hpp"
 #include "lib/spotify/episode.hpp"
 #include "lib/spotify/callback.hpp"
+#include "lib/spotify/paginator.hpp"
+#include "lib/spotify/tokenmanager.hpp"
 #include "lib/httpclient.hpp"
+#include "lib/httpcache.hpp"
 #include "lib/datetime.hpp"
 
 #include "thirdparty/json.hpp"
@@ -104,6 +107,11 @@ namespace lib
 
 			void saved_tracks(lib::callback<std::vector<lib::spt::track>> &callback);
 
+			/**
+			 * Get saved tracks, one page at a time
+			 */
+			void saved_tracks(lib::paged<std::vector<lib::spt::track>> &callback);
+
 			void add_saved_tracks(const std::vector<std::string> &track_ids,
 				lib::callback<std::string> &callback);
 
@@ -264,6 +272,26 @@ namespace lib
 			void playlist_tracks(const lib::spt::playlist &playlist,
 				lib::callback<std::vector<lib::spt::track>> &callback);
 
+			/**
+			 * Get tracks in playlist, one page at a time
+			 */
+			void playlist_tracks(const lib::spt::playlist &playlist,
+				lib::paged<std::vector<lib::spt::track>> &callback);
+
+			/**
+			 * Get a single page of tracks in playlist
+			 * @param offset Index of first track
+			 * @param limit Maximum number of tracks, at most 100
+			 */
+			void playlist_tracks(const lib::spt::playlist &playlist, size_t offset, size_t limit,
+				lib::callback<std::vector<lib::spt::track>> &callback);
+
+			/**
+			 * Get only ID, name, and added date, of all tracks in playlist
+			 */
+			void playlist_track_ids(const lib::spt::playlist &playlist,
+				lib::callback<std::vector<lib::spt::track>> &callback);
+
 			void add_to_playlist(const std::string &playlist_id,
 				const std::vector<std::string> &track_uris,
 				lib::callback<std::string> &callback);
@@ -313,11 +341,18 @@ namespace lib
 			//endregion
 
 			/**
-			 * Refresh access token with refresh token
-			 * @return Refresh was successful
+			 * Refresh access token with refresh token, if expired, or forced
+			 * @throws lib::spt::error
+			 * @deprecated Use asynchronous method
 			 */
 			void refresh(bool force = false);
 
+			/**
+			 * Refresh access token with refresh token in the background
+			 * @param callback Error message, or empty if successful
+			 */
+			void refresh(lib::callback<std::string> &callback);
+
 			/**
 			 * Spotify ID (4uLU6hMCjMI75M1A2tKUQC) to Spotify URI
 			 * (spotify:track:4uLU6hMCjMI75M1A2tKUQC)
@@ -345,6 +380,12 @@ namespace lib
 			static auto get_device_url(const std::string &url,
 				const lib::spt::device &device) -> std::string;
 
+			/**
+			 * Set maximum number of pages requested at once when loading a collection
+			 * @param value Number of requests, 1 to load one page at a time
+			 */
+			void set_max_page_requests(size_t value);
+
 		protected:
 			/**
 			 * Allow use to select device, by default, none is chosen
@@ -354,11 +395,6 @@ namespace lib
 			virtual void select_device(const std::vector<lib::spt::device> &devices,
 				lib::callback<lib::spt::device> &callback);
 
-			/**
-			 * Timestamp of last refresh
-			 */
-			long last_auth = 0;
-
 			/**
 			 * Settings
 			 */
@@ -391,6 +427,14 @@ namespace lib
 			void get_items(const std::string &url, const std::string &key,
 				lib::callback<nlohmann::json> &callback);
 
+			/**
+			 * GET a collection of items, one page at a time
+			 * @param url URL to request
+			 * @param callback Items in each page, in order
+			 */
+			void get_pages(const std::string &url,
+				lib::paged<nlohmann::json> &callback);
+
 			//endregion
 
 			//region PUT
@@ -453,6 +497,11 @@ namespace lib
 			 */
 			static auto follow_type_string(lib::follow_type type) -> std::string;
 
+			/**
+			 * Number of GET requests answered from cache
+			 */
+			auto get_response_stats() const -> const lib::http_cache::stats &;
+
 		private:
 			/**
 			 * Implementation of HTTP Client
@@ -460,14 +509,9 @@ namespace lib
 			const lib::http_client &http;
 
 			/**
-			 * Send request to refresh access token
-			 * @param post_data POST form data
-			 * @param authorization Authorization header
-			 * @note Only required until networking is properly implemented
-			 * @return JSON response with (maybe) new access token
+			 * Maximum number of in-flight page requests
 			 */
-			auto request_refresh(const std::string &post_data,
-				const std::string &authorization) -> std::string;
+			size_t max_page_requests = 4;
 
 			/**
 			 * Parse JSON from string data
@@ -486,15 +530,52 @@ namespace lib
 				const std::string &data) -> std::string;
 
 			/**
-			 * Get authorization header, and refresh if needed
+			 * Access token
 			 */
-			auto auth_headers() -> lib::headers;
+			lib::spt::token_manager tokens;
+
+			/**
+			 * Maximum total size of cached GET responses, in bytes
+			 */
+			static constexpr size_t max_response_cache_size = 8 * 1024 * 1024;
+
+			/**
+			 * Cached GET responses
+			 */
+			lib::http_cache responses;
+
+			/**
+			 * Get authorization header, and wait for refresh if needed
+			 * @param content_type Content-Type header to add
+			 */
+			void auth_headers(const std::string &content_type,
+				lib::callback<lib::headers> &callback);
+
+			/**
+			 * Send GET request, answered from cache if not modified
+			 * @param headers Headers of request, without conditional headers
+			 * @param conditional Only get response if modified since cached
+			 */
+			void get_response(const std::string &url, const lib::headers &headers,
+				bool conditional, lib::callback<nlohmann::json> &callback);
+
+			/**
+			 * GET a single page of a collection
+			 * @param url Full or relative URL to page
+			 */
+			void get_page(const std::string &url, lib::callback<nlohmann::json> &callback);
 
 			/**
 			 * Get full API url from relative URL
 			 */
 			static auto to_full_url(const std::string &relative_url) -> std::string;
 
+			/**
+			 * Get URL to load tracks in playlist from
+			 */
+			void playlist_tracks_url(const lib::spt::playlist &playlist,
+				lib::callback<std::string> &callback);
+
 			/**
 			 * Set last used device
 			 * @param id Device ID
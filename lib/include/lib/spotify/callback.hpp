@@ -15,4 +15,11 @@ namespace lib
 	 */
 	template<typename T>
 	using result = const std::function<void(bool success, const T &result)>;
+
+	/**
+	 * Callback called once for each page of a paged result, in order,
+	 * with bool indicating if it's the last page
+	 */
+	template<typename T>
+	using paged = const std::function<void(const T &page, bool is_last)>;
 }
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "lib/spotify/callback.hpp"
+#include "lib/uri.hpp"
+#include "lib/json.hpp"
+
+#include "thirdparty/json.hpp"
+
+#include <memory>
+
+namespace lib
+{
+	namespace spt
+	{
+		/**
+		 * Loads all pages of a paged collection
+		 */
+		class paginator: public std::enable_shared_from_this<paginator>
+		{
+		public:
+			/**
+			 * Function used to request a single page
+			 */
+			using fetcher = std::function<void(const std::string &url,
+				lib::callback<nlohmann::json> &callback)>;
+
+			/**
+			 * Load all items in a collection
+			 * @param url URL to first page
+			 * @param key Key items are contained in, or empty if none
+			 * @param max_requests Maximum number of page requests in-flight at once
+			 * @param fetch Function to request a page with
+			 * @param callback All items, in offset order
+			 * @note If the collection is offset based, remaining pages are requested
+			 * concurrently, otherwise, each page is requested one at a time
+			 */
+			static void load(const std::string &url, const std::string &key,
+				size_t max_requests, const fetcher &fetch,
+				lib::callback<nlohmann::json> &callback);
+
+			/**
+			 * Load all items in a collection, one page at a time
+			 * @param callback Items in each page, in offset order
+			 * @note Same as load, but pages are returned as soon as all pages before
+			 * them have been returned
+			 */
+			static void stream(const std::string &url, const std::string &key,
+				size_t max_requests, const fetcher &fetch,
+				lib::paged<nlohmann::json> &callback);
+
+			/**
+			 * Get URL to page at specified offset
+			 * @param url URL to any page in collection
+			 * @param offset Offset of first item in page
+			 * @return URL, or empty if URL isn't offset based
+			 */
+			static auto page_url(const std::string &url, size_t offset) -> std::string;
+
+		private:
+			paginator(const std::string &key, size_t max_requests, fetcher fetch);
+
+			const std::string key;
+			const size_t max_requests;
+			const fetcher fetch;
+
+			/**
+			 * All items once everything is loaded, if loading
+			 */
+			std::function<void(const nlohmann::json &)> callback;
+
+			/**
+			 * Each page once loaded, if streaming
+			 */
+			std::function<void(const nlohmann::json &, bool)> page_callback;
+
+			/**
+			 * Pages in offset order, null if not yet loaded
+			 */
+			std::vector<nlohmann::json> pages;
+
+			/**
+			 * URL to a page, used to create other page URLs from
+			 */
+			std::string base_url;
+
+			size_t first_offset = 0;
+			size_t limit = 0;
+			size_t next_page = 0;
+			size_t loaded_pages = 0;
+			size_t streamed_pages = 0;
+
+			/**
+			 * Number of pages is known and all of them have been requested
+			 */
+			bool complete = false;
+
+			/**
+			 * Start loading collection
+			 */
+			static void start(const std::shared_ptr<paginator> &instance,
+				const std::string &url);
+
+			/**
+			 * Set items of loaded page
+			 */
+			void set_page(size_t index, const nlohmann::json &json);
+
+			/**
+			 * Get content of page, items and paging info
+			 */
+			auto content(const nlohmann::json &json) const -> const nlohmann::json &;
+
+			/**
+			 * First page loaded, decide how to load the rest
+			 */
+			void first_loaded(const nlohmann::json &json);
+
+			/**
+			 * Request pages until max_requests are in-flight
+			 */
+			void request_pages();
+
+			/**
+			 * A page requested concurrently was loaded
+			 */
+			void page_loaded(size_t index, const nlohmann::json &json);
+
+			/**
+			 * Follow "next" of page, for cursor based collections
+			 */
+			void load_next(const nlohmann::json &json);
+
+			/**
+			 * Send all pages ready to be streamed
+			 */
+			void stream_pages();
+
+			/**
+			 * All pages loaded, combine and return
+			 */
+			void finish();
+		};
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "lib/spotify/playback.hpp"
+
+#include <chrono>
+
+namespace lib
+{
+	namespace spt
+	{
+		/**
+		 * Latest known playback, with what changed since previous update
+		 */
+		class playback_state
+		{
+		public:
+			/**
+			 * Milliseconds
+			 */
+			using ms = std::chrono::milliseconds;
+
+			/**
+			 * Monotonic clock
+			 */
+			using clock = std::chrono::steady_clock;
+
+			/**
+			 * Parts of playback that changed
+			 */
+			struct changes
+			{
+				bool track = false;
+				bool playing = false;
+				bool progress = false;
+				bool volume = false;
+				bool shuffle = false;
+				bool repeat = false;
+
+				/**
+				 * Anything changed
+				 */
+				auto any() const -> bool;
+			};
+
+			/**
+			 * Replace playback
+			 * @param time When progress in playback was reported
+			 * @return What changed, everything if first update
+			 */
+			auto update(const lib::spt::playback &playback, clock::time_point time) -> changes;
+
+			/**
+			 * Replace playback, reported now
+			 */
+			auto update(const lib::spt::playback &playback) -> changes;
+
+			/**
+			 * Latest playback, with progress as reported
+			 */
+			auto get() const -> const lib::spt::playback &;
+
+			/**
+			 * Progress at specified time, assuming playback continued since reported
+			 */
+			auto progress_ms(clock::time_point now) const -> int;
+
+			/**
+			 * Current progress
+			 */
+			auto progress_ms() const -> int;
+
+			/**
+			 * Time until playback should be requested again, slower when nothing is playing,
+			 * or not visible, but faster when current track is about to end
+			 * @param interval Interval when playing and visible
+			 * @param is_visible Playback is shown to the user
+			 * @param now Current time
+			 */
+			auto poll_interval(ms interval, bool is_visible, clock::time_point now) const -> ms;
+
+			auto poll_interval(ms interval, bool is_visible) const -> ms;
+
+		private:
+			lib::spt::playback current;
+			clock::time_point updated;
+			bool has_playback = false;
+		};
+	}
+}
@@ -80,10 +80,10 @@ namespace lib
 			auto is_null() const -> bool;
 
 			/**
-			 * Compare snapshot and check if playlist is up to date
+			 * Cached playlist has the same snapshot, and all tracks
+			 * @param cached Previously saved playlist
 			 */
-			auto is_up_to_date(const std::string &snapshot,
-				const lib::spt::user &current_user) const -> bool;
+			auto is_up_to_date(const lib::spt::playlist &cached) const -> bool;
 		};
 
 		void to_json(nlohmann::json &j, const playlist &p);
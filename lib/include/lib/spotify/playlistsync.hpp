@@ -0,0 +1,75 @@
+#pragma once
+
+#include "lib/spotify/api.hpp"
+#include "lib/cache.hpp"
+
+#include <map>
+
+namespace lib
+{
+	namespace spt
+	{
+		/**
+		 * Keeps cached tracks of playlists up to date, using the snapshot ID
+		 */
+		class playlist_sync
+		{
+		public:
+			/**
+			 * Playlist with tracks, and if tracks changed since cached
+			 */
+			using synced = std::function<void(const lib::spt::playlist &playlist, bool changed)>;
+
+			/**
+			 * Get tracks in playlist from cache if snapshot matches, otherwise only
+			 * download pages with tracks that aren't already cached, and update cache
+			 * @param playlist Playlist with latest snapshot
+			 */
+			static void sync(lib::spt::api &spotify, lib::cache &cache,
+				const lib::spt::playlist &playlist, const synced &callback);
+
+			/**
+			 * Pages with tracks that aren't cached
+			 * @param cached Cached tracks
+			 * @param items Current tracks, only ID, or name if local, and added date is required
+			 * @param page_size Number of tracks in each page
+			 * @return Page indices
+			 */
+			static auto changed_pages(const std::vector<lib::spt::track> &cached,
+				const std::vector<lib::spt::track> &items,
+				size_t page_size) -> std::vector<size_t>;
+
+			/**
+			 * Combine cached tracks with downloaded pages
+			 * @param pages Downloaded pages, by page index
+			 * @param tracks Tracks in current order
+			 * @return All tracks were found
+			 */
+			static auto merge(const std::vector<lib::spt::track> &cached,
+				const std::vector<lib::spt::track> &items,
+				const std::map<size_t, std::vector<lib::spt::track>> &pages,
+				size_t page_size, std::vector<lib::spt::track> &tracks) -> bool;
+
+		private:
+			/**
+			 * Index of cached track for each item, or -1 if not cached
+			 */
+			static auto match(const std::vector<lib::spt::track> &cached,
+				const std::vector<lib::spt::track> &items) -> std::vector<long>;
+
+			/**
+			 * Identifies track in playlist, or empty if it can't be identified
+			 */
+			static auto key(const lib::spt::track &track) -> std::string;
+
+			/**
+			 * Download all tracks in playlist
+			 */
+			static void load_all(lib::spt::api &spotify, lib::cache &cache,
+				const lib::spt::playlist &playlist, const synced &callback);
+
+			static void loaded(lib::cache &cache, const lib::spt::playlist &playlist,
+				const std::vector<lib::spt::track> &tracks, const synced &callback);
+		};
+	}
+}
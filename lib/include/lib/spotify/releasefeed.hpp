@@ -0,0 +1,58 @@
+#pragma once
+
+#include "lib/cache/playlistindex.hpp"
+#include "lib/spotify/album.hpp"
+#include "lib/spotify/callback.hpp"
+#include "lib/spotify/track.hpp"
+#include "lib/stopwatch.hpp"
+
+#include <memory>
+
+namespace lib
+{
+	namespace spt
+	{
+		/**
+		 * Loads tracks of new releases from artists in the user's playlists
+		 */
+		class release_feed: public std::enable_shared_from_this<release_feed>
+		{
+		public:
+			/**
+			 * Function used to request tracks of a single album
+			 */
+			using fetcher = std::function<void(const lib::spt::album &album,
+				lib::callback<std::vector<lib::spt::track>> &callback)>;
+
+			/**
+			 * Load tracks of all releases by artists in any playlist
+			 * @param releases New releases
+			 * @param index Index of playlists to look for artists in
+			 * @param max_requests Maximum number of album requests in-flight at once
+			 * @param fetch Function to request album tracks with
+			 * @param callback All tracks, newest album first, with release date as added date
+			 */
+			static void load(const std::vector<lib::spt::album> &releases,
+				const lib::playlist_index &index, size_t max_requests, const fetcher &fetch,
+				lib::callback<std::vector<lib::spt::track>> &callback);
+
+		private:
+			release_feed(size_t max_requests, fetcher fetch);
+
+			size_t max_requests;
+			fetcher fetch;
+			std::function<void(const std::vector<lib::spt::track> &)> callback;
+
+			std::vector<lib::spt::album> albums;
+			std::vector<std::vector<lib::spt::track>> tracks;
+
+			size_t next_album = 0;
+			size_t loaded_albums = 0;
+			lib::stopwatch stopwatch;
+
+			void request_albums();
+			void album_loaded(size_t index, const std::vector<lib::spt::track> &results);
+			void finish();
+		};
+	}
+}
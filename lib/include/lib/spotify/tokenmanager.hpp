@@ -0,0 +1,99 @@
+#pragma once
+
+#include "lib/httpclient.hpp"
+#include "lib/settings.hpp"
+#include "lib/spotify/callback.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace lib
+{
+	namespace spt
+	{
+		/**
+		 * Keeps access token valid, by refreshing it in the background before it expires
+		 */
+		class token_manager
+		{
+		public:
+			/**
+			 * @param settings Settings with access token and refresh token
+			 * @param http_client HTTP client to refresh access token with
+			 */
+			token_manager(lib::settings &settings, const lib::http_client &http_client);
+
+			/**
+			 * Get authorization headers, waiting for access token to be refreshed if expired
+			 * @param callback Headers, called right away if access token is still valid
+			 */
+			void headers(lib::callback<lib::headers> &callback);
+
+			/**
+			 * Refresh access token in the background
+			 * @param callback Error message, or empty if successful
+			 */
+			void refresh(lib::callback<std::string> &callback);
+
+			/**
+			 * Refresh access token, and wait for it to finish
+			 * @throws lib::spt::error
+			 * @deprecated Use asynchronous method
+			 */
+			void refresh();
+
+			/**
+			 * Seconds until access token expires, or negative if already expired
+			 */
+			auto expires_in() const -> long;
+
+			/**
+			 * Access token is currently being refreshed
+			 */
+			auto is_refreshing() const -> bool;
+
+		private:
+			/**
+			 * How long access tokens are valid for, in seconds
+			 */
+			static constexpr long token_lifetime = 60 * 60;
+
+			/**
+			 * How long before expiring to refresh access token, in seconds
+			 */
+			static constexpr long refresh_margin = 5 * 60;
+
+			lib::settings &settings;
+			const lib::http_client &http;
+
+			bool refreshing = false;
+
+			/**
+			 * Requests waiting for access token to be refreshed
+			 */
+			std::vector<std::function<void(const lib::headers &)>> waiting;
+
+			/**
+			 * Callbacks waiting for refresh to finish
+			 */
+			std::vector<std::function<void(const std::string &)>> refresh_callbacks;
+
+			auto current_headers() const -> lib::headers;
+			auto request_headers() const -> lib::headers;
+			auto request_body() const -> std::string;
+
+			/**
+			 * Start refresh, if not already refreshing
+			 */
+			void request_refresh();
+
+			/**
+			 * Save access token from response
+			 * @return Error message, or empty if successful
+			 */
+			auto save_token(const std::string &response) -> std::string;
+
+			void refreshed(const std::string &response);
+		};
+	}
+}
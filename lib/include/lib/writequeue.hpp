@@ -0,0 +1,118 @@
+#pragma once
+
+#include "thirdparty/filesystem.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace lib
+{
+	/**
+	 * Writes files in a background thread,
+	 * only writing the latest data if a file is written again before being written
+	 */
+	class write_queue
+	{
+	public:
+		/**
+		 * Creates data to write, called from background thread
+		 */
+		using serializer = std::function<std::string()>;
+
+		/**
+		 * Called from background thread after file is written, or failed to write
+		 */
+		using callback = std::function<void()>;
+
+		write_queue();
+
+		/**
+		 * Writes all pending files
+		 */
+		~write_queue();
+
+		/**
+		 * Shared instance
+		 */
+		static auto get() -> write_queue &;
+
+		/**
+		 * Write file in background
+		 * @param path File to write to
+		 * @param serialize Creates data to write
+		 */
+		void write(const ghc::filesystem::path &path, serializer serialize);
+
+		/**
+		 * Write file in background
+		 * @param path File to write to
+		 * @param serialize Creates data to write
+		 * @param written Called when done writing, unless replaced by a later write
+		 */
+		void write(const ghc::filesystem::path &path, serializer serialize, callback written);
+
+		/**
+		 * Remove file in background, replacing any pending write of it
+		 * @param path File to remove
+		 */
+		void remove(const ghc::filesystem::path &path);
+
+		/**
+		 * Remove file in background, replacing any pending write of it
+		 * @param path File to remove
+		 * @param removed Called when done removing, unless replaced by a later write
+		 */
+		void remove(const ghc::filesystem::path &path, callback removed);
+
+		/**
+		 * Wait for all pending files to be written
+		 */
+		void flush();
+
+		/**
+		 * Wait for file to be written, if pending
+		 */
+		void flush(const ghc::filesystem::path &path);
+
+		/**
+		 * Write to a temporary file, then replace file with it
+		 * @return File was written
+		 */
+		static auto write_atomic(const ghc::filesystem::path &path,
+			const std::string &data) -> bool;
+
+		/**
+		 * File is a temporary file, not yet replacing the actual file
+		 */
+		static auto is_temp(const ghc::filesystem::path &path) -> bool;
+
+	private:
+		struct item
+		{
+			/**
+			 * Empty if file should be removed
+			 */
+			serializer serialize;
+			callback written;
+		};
+
+		std::map<std::string, item> pending;
+		std::map<std::string, item> writing;
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::condition_variable written;
+		bool stopped = false;
+
+		/**
+		 * Declared last, as it's started before the constructor body
+		 */
+		std::thread thread;
+
+		void run();
+	};
+}
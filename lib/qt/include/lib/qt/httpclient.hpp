@@ -1,11 +1,13 @@
 #pragma once
 
 #include "lib/httpclient.hpp"
+#include "lib/requestscheduler.hpp"
 
 #include <QObject>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QCoreApplication>
+#include <QEventLoop>
 
 namespace lib
 {
@@ -22,6 +24,9 @@ namespace lib
 				const lib::headers &headers,
 				lib::callback<std::string> &callback) const override;
 
+			void get_response(const std::string &url, const lib::headers &headers,
+				lib::callback<lib::http_response> &callback) const override;
+
 			void put(const std::string &url, const std::string &body,
 				const lib::headers &headers,
 				lib::callback<std::string> &callback) const override;
@@ -35,13 +40,46 @@ namespace lib
 			void del(const std::string &url, const std::string &body, const lib::headers &headers,
 				lib::callback<std::string> &callback) const override;
 
+			/**
+			 * Scheduler for asynchronous requests
+			 */
+			auto get_scheduler() const -> const lib::request_scheduler &;
+
 		private:
+			/**
+			 * Same as the default limit of connections per host in Qt,
+			 * raised by the scheduler once HTTP/2 is used
+			 */
+			static constexpr size_t max_requests_per_host = 6;
+
 			QNetworkAccessManager *network_manager = nullptr;
+			mutable lib::request_scheduler scheduler;
 
 			static auto request(const std::string &url,
 				const lib::headers &headers) -> QNetworkRequest;
 
-			void await(QNetworkReply *reply, lib::callback<QByteArray> &callback) const;
+			/**
+			 * Send request once there is room for it
+			 * @param url URL of request
+			 * @param sender Sends prepared request
+			 * @param callback Finished reply, deleted after callback
+			 */
+			void send(const std::string &url, const lib::headers &headers,
+				const std::function<QNetworkReply *(const QNetworkRequest &)> &sender,
+				lib::callback<QNetworkReply *> &callback) const;
+
+			/**
+			 * Reply was sent over HTTP/2
+			 */
+			static auto was_multiplexed(QNetworkReply *reply) -> bool;
+
+			/**
+			 * Callback with body of reply
+			 */
+			static auto read_body(lib::callback<std::string> &callback)
+			-> std::function<void(QNetworkReply *)>;
+
+			void await(QNetworkReply *reply, lib::callback<QNetworkReply *> &callback) const;
 		};
 	}
 }
@@ -2,9 +2,20 @@
 
 lib::qt::http_client::http_client(QObject *parent)
 	: QObject(parent),
-	lib::http_client()
+	lib::http_client(),
+	scheduler(max_requests_per_host)
 {
 	network_manager = new QNetworkAccessManager(this);
+
+#ifndef QT_NO_SSL
+	// Open connection to the API early, so it can be reused by the first requests
+	network_manager->connectToHostEncrypted(QStringLiteral("api.spotify.com"));
+#endif
+}
+
+auto lib::qt::http_client::get_scheduler() const -> const lib::request_scheduler &
+{
+	return scheduler;
 }
 
 auto lib::qt::http_client::request(const std::string &url,
@@ -13,6 +24,13 @@ auto lib::qt::http_client::request(const std::string &url,
 	// Prepare request
 	QNetworkRequest request(QUrl(QString::fromStdString(url)));
 
+	// Multiplex requests to the same host over a single connection if supported
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+#else
+	request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+#endif
+
 	// Set headers
 	for (const auto &header: headers)
 	{
@@ -24,7 +42,55 @@ auto lib::qt::http_client::request(const std::string &url,
 	return request;
 }
 
-void lib::qt::http_client::await(QNetworkReply *reply, lib::callback<QByteArray> &callback) const
+void lib::qt::http_client::send(const std::string &url, const lib::headers &headers,
+	const std::function<QNetworkReply *(const QNetworkRequest &)> &sender,
+	lib::callback<QNetworkReply *> &callback) const
+{
+	const auto priority = lib::request_scheduler::priority(url);
+
+	scheduler.schedule(url, priority,
+		[this, url, headers, priority, sender, callback](const std::function<void()> &finished)
+		{
+			auto prepared = request(url, headers);
+			prepared.setPriority(priority == lib::request_priority::playback
+				? QNetworkRequest::HighPriority
+				: priority == lib::request_priority::image
+					? QNetworkRequest::LowPriority
+					: QNetworkRequest::NormalPriority);
+
+			await(sender(prepared), [this, url, finished, callback](QNetworkReply *reply)
+			{
+				if (was_multiplexed(reply))
+				{
+					scheduler.set_multiplexed(url);
+				}
+
+				finished();
+				callback(reply);
+			});
+		});
+}
+
+auto lib::qt::http_client::was_multiplexed(QNetworkReply *reply) -> bool
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	return reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+#else
+	return reply->attribute(QNetworkRequest::HTTP2WasUsedAttribute).toBool();
+#endif
+}
+
+auto lib::qt::http_client::read_body(lib::callback<std::string> &callback)
+-> std::function<void(QNetworkReply *)>
+{
+	return [callback](QNetworkReply *reply)
+	{
+		callback(reply->readAll().toStdString());
+	};
+}
+
+void lib::qt::http_client::await(QNetworkReply *reply,
+	lib::callback<QNetworkReply *> &callback) const
 {
 	QNetworkReply::connect(reply, &QNetworkReply::finished, this,
 		[reply, callback]()
@@ -35,7 +101,7 @@ void lib::qt::http_client::await(QNetworkReply *reply, lib::callback<QByteArray>
 					reply->errorString().toStdString());
 			}
 
-			callback(reply->readAll());
+			callback(reply);
 			reply->deleteLater();
 		});
 }
@@ -43,11 +109,32 @@ void lib::qt::http_client::await(QNetworkReply *reply, lib::callback<QByteArray>
 void lib::qt::http_client::get(const std::string &url, const lib::headers &headers,
 	lib::callback<std::string> &callback) const
 {
-	await(network_manager->get(request(url, headers)),
-		[url, callback](const QByteArray &data)
+	send(url, headers, [this](const QNetworkRequest &request) -> QNetworkReply *
+	{
+		return network_manager->get(request);
+	}, read_body(callback));
+}
+
+void lib::qt::http_client::get_response(const std::string &url, const lib::headers &headers,
+	lib::callback<lib::http_response> &callback) const
+{
+	send(url, headers, [this](const QNetworkRequest &request) -> QNetworkReply *
+	{
+		return network_manager->get(request);
+	}, [callback](QNetworkReply *reply)
+	{
+		lib::http_response response;
+		response.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+		response.body = reply->readAll().toStdString();
+
+		for (const auto &header: reply->rawHeaderPairs())
 		{
-			callback(data.toStdString());
-		});
+			response.headers[header.first.toLower().toStdString()]
+				= header.second.toStdString();
+		}
+
+		callback(response);
+	});
 }
 
 void lib::qt::http_client::put(const std::string &url, const std::string &body,
@@ -57,11 +144,10 @@ void lib::qt::http_client::put(const std::string &url, const std::string &body,
 		? QByteArray()
 		: QByteArray::fromStdString(body);
 
-	await(network_manager->put(request(url, headers), data),
-		[url, body, callback](const QByteArray &data)
-		{
-			callback(data.toStdString());
-		});
+	send(url, headers, [this, data](const QNetworkRequest &request) -> QNetworkReply *
+	{
+		return network_manager->put(request, data);
+	}, read_body(callback));
 }
 
 void lib::qt::http_client::post(const std::string &url, const std::string &body,
@@ -71,11 +157,10 @@ void lib::qt::http_client::post(const std::string &url, const std::string &body,
 		? QByteArray()
 		: QByteArray::fromStdString(body);
 
-	await(network_manager->post(request(url, headers), data),
-		[url, callback](const QByteArray &data)
-		{
-			callback(data.toStdString());
-		});
+	send(url, headers, [this, data](const QNetworkRequest &request) -> QNetworkReply *
+	{
+		return network_manager->post(request, data);
+	}, read_body(callback));
 }
 
 auto lib::qt::http_client::post(const std::string &url, const lib::headers &headers,
@@ -84,12 +169,19 @@ auto lib::qt::http_client::post(const std::string &url, const lib::headers &head
 	// Send request
 	auto *reply = network_manager->post(request(url, headers),
 		QByteArray::fromStdString(post_data));
-	while (!reply->isFinished())
+
+	// Wait without spinning
+	if (!reply->isFinished())
 	{
-		QCoreApplication::processEvents();
+		QEventLoop loop;
+		QNetworkReply::connect(reply, &QNetworkReply::finished,
+			&loop, &QEventLoop::quit);
+		loop.exec();
 	}
 
-	return reply->readAll().toStdString();
+	auto data = reply->readAll().toStdString();
+	reply->deleteLater();
+	return data;
 }
 
 void lib::qt::http_client::del(const std::string &url, const std::string &body,
@@ -99,9 +191,8 @@ void lib::qt::http_client::del(const std::string &url, const std::string &body,
 		? QByteArray()
 		: QByteArray::fromStdString(body);
 
-	await(network_manager->sendCustomRequest(request(url, headers), "DELETE", data),
-		[url, callback](const QByteArray &data)
-		{
-			callback(data.toStdString());
-		});
+	send(url, headers, [this, data](const QNetworkRequest &request) -> QNetworkReply *
+	{
+		return network_manager->sendCustomRequest(request, "DELETE", data);
+	}, read_body(callback));
 }
@@ -0,0 +1,306 @@
+#include "lib/cache/binarycache.hpp"
+#include "lib/cache/binaryformat.hpp"
+
+#include <set>
+
+// Identifies file as binary tracks, "SQTT" in little-endian
+constexpr uint32_t tracks_magic = 0x54545153;
+
+constexpr uint8_t flag_local = 1U << 0U;
+constexpr uint8_t flag_playable = 1U << 1U;
+
+lib::binary_cache::binary_cache(const lib::paths &paths)
+	: json_cache(paths),
+	pending(std::make_shared<pending_tracks>())
+{
+}
+
+//region tracks
+
+auto lib::binary_cache::get_tracks(const std::string &entity_id) const
+-> std::vector<lib::spt::track>
+{
+	// Tracks may still be saving in the background
+	{
+		std::lock_guard<std::mutex> lock(pending->mutex);
+		const auto item = pending->items.find(entity_id);
+		if (item != pending->items.end())
+		{
+			return *item->second;
+		}
+	}
+
+	std::ifstream file(path("tracks", entity_id, "bin"), std::ios::binary);
+	if (!file.is_open() || file.bad())
+	{
+		return migrate_tracks(entity_id);
+	}
+
+	const std::vector<unsigned char> data{
+		std::istreambuf_iterator<char>(file),
+		std::istreambuf_iterator<char>(),
+	};
+
+	return deserialize(data);
+}
+
+void lib::binary_cache::set_tracks(const std::string &entity_id,
+	const std::vector<lib::spt::track> &tracks)
+{
+	save_tracks(entity_id, tracks);
+}
+
+void lib::binary_cache::save_tracks(const std::string &entity_id,
+	const std::vector<lib::spt::track> &tracks) const
+{
+	// Can't move into lambda in C++11
+	std::shared_ptr<const std::vector<lib::spt::track>> item
+		= std::make_shared<std::vector<lib::spt::track>>(tracks);
+
+	const auto state = pending;
+	{
+		std::lock_guard<std::mutex> lock(state->mutex);
+		state->items[entity_id] = item;
+	}
+
+	lib::write_queue::get().write(path("tracks", entity_id, "bin"), [item]() -> std::string
+	{
+		const auto data = serialize(*item);
+		return std::string(data.cbegin(), data.cend());
+	}, [state, entity_id, item]()
+	{
+		// Only remove if not saved again since
+		std::lock_guard<std::mutex> lock(state->mutex);
+		const auto pending_item = state->items.find(entity_id);
+		if (pending_item != state->items.end() && pending_item->second == item)
+		{
+			state->items.erase(pending_item);
+		}
+	});
+}
+
+auto lib::binary_cache::all_tracks() const -> std::map<std::string, std::vector<lib::spt::track>>
+{
+	auto dir = paths.cache() / "tracks";
+	std::map<std::string, std::vector<lib::spt::track>> results;
+
+	// Collect first, as loading may migrate, and modify, files in directory
+	std::set<std::string> entity_ids;
+	{
+		// Check pending first, as they're removed after being written
+		std::lock_guard<std::mutex> lock(pending->mutex);
+		for (const auto &item: pending->items)
+		{
+			entity_ids.insert(item.first);
+		}
+	}
+	for (const auto &file: lib::json::list(dir))
+	{
+		entity_ids.insert(file.stem().string());
+	}
+
+	for (const auto &entity_id: entity_ids)
+	{
+		results[entity_id] = get_tracks(entity_id);
+	}
+
+	return results;
+}
+
+auto lib::binary_cache::migrate_tracks(const std::string &entity_id) const
+-> std::vector<lib::spt::track>
+{
+	const auto json_path = ghc::filesystem::path(paths.cache()) / "tracks"
+		/ file(entity_id, "json");
+
+	// Loaded from memory if still saving in the background
+	const auto json = lib::json::load(json_path);
+	if (json.is_null())
+	{
+		return {};
+	}
+
+	const auto tracks = json.get<std::vector<lib::spt::track>>();
+	save_tracks(entity_id, tracks);
+
+	// Queued after tracks, so they're saved before it's removed
+	lib::json::remove(json_path);
+
+	return tracks;
+}
+
+//endregion
+
+//region format
+
+auto lib::binary_cache::serialize(const std::vector<lib::spt::track> &tracks)
+-> std::vector<unsigned char>
+{
+	const auto count = static_cast<uint32_t>(tracks.size());
+
+	string_table strings;
+	binary_writer columns;
+	columns.write_u32(count);
+
+	// Each property is stored as a column, with strings as index in string table
+	for (const auto &track: tracks)
+	{
+		columns.write_u32(strings.index_of(track.id));
+	}
+	for (const auto &track: tracks)
+	{
+		columns.write_u32(strings.index_of(track.name));
+	}
+	for (const auto &track: tracks)
+	{
+		columns.write_u32(strings.index_of(track.album.id));
+	}
+	for (const auto &track: tracks)
+	{
+		columns.write_u32(strings.index_of(track.album.name));
+	}
+	for (const auto &track: tracks)
+	{
+		columns.write_u32(strings.index_of(track.added_at));
+	}
+	for (const auto &track: tracks)
+	{
+		columns.write_u32(static_cast<uint32_t>(track.duration));
+	}
+	for (const auto &track: tracks)
+	{
+		columns.write_u8(static_cast<uint8_t>((track.is_local ? flag_local : 0U)
+			| (track.is_playable ? flag_playable : 0U)));
+	}
+
+	for (const auto &track: tracks)
+	{
+		columns.write_u32(static_cast<uint32_t>(track.artists.size()));
+	}
+	for (const auto &track: tracks)
+	{
+		for (const auto &artist: track.artists)
+		{
+			columns.write_u32(strings.index_of(artist.id));
+			columns.write_u32(strings.index_of(artist.name));
+		}
+	}
+
+	for (const auto &track: tracks)
+	{
+		columns.write_u32(static_cast<uint32_t>(track.images.size()));
+	}
+	for (const auto &track: tracks)
+	{
+		for (const auto &image: track.images)
+		{
+			columns.write_u32(strings.index_of(image.url));
+			columns.write_u32(static_cast<uint32_t>(image.width));
+			columns.write_u32(static_cast<uint32_t>(image.height));
+		}
+	}
+
+	binary_writer writer;
+	writer.write_u32(tracks_magic);
+	writer.write_u32(version);
+	strings.write(writer);
+	writer.write(columns);
+
+	return writer.data();
+}
+
+auto lib::binary_cache::deserialize(const std::vector<unsigned char> &data)
+-> std::vector<lib::spt::track>
+{
+	try
+	{
+		binary_reader reader(data);
+		if (reader.read_u32() != tracks_magic)
+		{
+			lib::log::warn("Failed to load tracks from cache: invalid format");
+			return {};
+		}
+
+		if (reader.read_u32() != version)
+		{
+			// Outdated, will be replaced when refreshed
+			return {};
+		}
+
+		string_table strings;
+		strings.read(reader);
+
+		// Each track is at least an id
+		std::vector<lib::spt::track> tracks(reader.read_count(4));
+
+		for (auto &track: tracks)
+		{
+			track.id = strings.at(reader.read_u32());
+		}
+		for (auto &track: tracks)
+		{
+			track.name = strings.at(reader.read_u32());
+		}
+		for (auto &track: tracks)
+		{
+			track.album.id = strings.at(reader.read_u32());
+		}
+		for (auto &track: tracks)
+		{
+			track.album.name = strings.at(reader.read_u32());
+		}
+		for (auto &track: tracks)
+		{
+			track.added_at = strings.at(reader.read_u32());
+		}
+		for (auto &track: tracks)
+		{
+			track.duration = static_cast<int>(reader.read_u32());
+		}
+		for (auto &track: tracks)
+		{
+			const auto flags = reader.read_u8();
+			track.is_local = (flags & flag_local) != 0;
+			track.is_playable = (flags & flag_playable) != 0;
+		}
+
+		for (auto &track: tracks)
+		{
+			// Each artist is an id and a name
+			track.artists.resize(reader.read_count(8));
+		}
+		for (auto &track: tracks)
+		{
+			for (auto &artist: track.artists)
+			{
+				artist.id = strings.at(reader.read_u32());
+				artist.name = strings.at(reader.read_u32());
+			}
+		}
+
+		for (auto &track: tracks)
+		{
+			// Each image is a url, width and height
+			track.images.resize(reader.read_count(12));
+		}
+		for (auto &track: tracks)
+		{
+			for (auto &image: track.images)
+			{
+				image.url = strings.at(reader.read_u32());
+				image.width = static_cast<int>(reader.read_u32());
+				image.height = static_cast<int>(reader.read_u32());
+			}
+		}
+
+		return tracks;
+	}
+	catch (const std::exception &e)
+	{
+		lib::log::warn("Failed to load tracks from cache: {}", e.what());
+	}
+
+	return {};
+}
+
+//endregion
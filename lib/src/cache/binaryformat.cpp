@@ -0,0 +1,144 @@
+#include "lib/cache/binaryformat.hpp"
+
+#include <stdexcept>
+
+//region binary_writer
+
+void lib::binary_writer::write_u8(uint8_t value)
+{
+	buffer.push_back(value);
+}
+
+void lib::binary_writer::write_u32(uint32_t value)
+{
+	constexpr int bits = 8;
+	constexpr uint32_t mask = 0xff;
+
+	for (auto i = 0; i < 4; i++)
+	{
+		buffer.push_back(static_cast<unsigned char>((value >> (i * bits)) & mask));
+	}
+}
+
+void lib::binary_writer::write_string(const std::string &value)
+{
+	write_u32(static_cast<uint32_t>(value.size()));
+	buffer.insert(buffer.end(), value.cbegin(), value.cend());
+}
+
+void lib::binary_writer::write(const binary_writer &writer)
+{
+	buffer.insert(buffer.end(), writer.buffer.cbegin(), writer.buffer.cend());
+}
+
+auto lib::binary_writer::data() const -> const std::vector<unsigned char> &
+{
+	return buffer;
+}
+
+//endregion
+
+//region binary_reader
+
+lib::binary_reader::binary_reader(const std::vector<unsigned char> &data)
+	: data(data)
+{
+}
+
+auto lib::binary_reader::read_u8() -> uint8_t
+{
+	require(1);
+	return data[position++];
+}
+
+auto lib::binary_reader::read_u32() -> uint32_t
+{
+	constexpr int bits = 8;
+	require(4);
+
+	uint32_t value = 0;
+	for (auto i = 0; i < 4; i++)
+	{
+		value |= static_cast<uint32_t>(data[position++]) << (i * bits);
+	}
+	return value;
+}
+
+auto lib::binary_reader::read_string() -> std::string
+{
+	const auto size = read_count(1);
+	std::string value(data.cbegin() + static_cast<long>(position),
+		data.cbegin() + static_cast<long>(position + size));
+	position += size;
+	return value;
+}
+
+auto lib::binary_reader::read_count(size_t item_size) -> uint32_t
+{
+	const auto count = read_u32();
+	require(count * item_size);
+	return count;
+}
+
+auto lib::binary_reader::at_end() const -> bool
+{
+	return position >= data.size();
+}
+
+void lib::binary_reader::require(size_t size) const
+{
+	if (size > data.size() - position)
+	{
+		throw std::out_of_range("unexpected end of data");
+	}
+}
+
+//endregion
+
+//region string_table
+
+auto lib::string_table::index_of(const std::string &value) -> uint32_t
+{
+	const auto item = indices.find(value);
+	if (item != indices.end())
+	{
+		return item->second;
+	}
+
+	const auto index = static_cast<uint32_t>(strings.size());
+	strings.push_back(value);
+	indices[value] = index;
+	return index;
+}
+
+auto lib::string_table::at(uint32_t index) const -> const std::string &
+{
+	return strings.at(index);
+}
+
+void lib::string_table::write(binary_writer &writer) const
+{
+	writer.write_u32(static_cast<uint32_t>(strings.size()));
+	for (const auto &value: strings)
+	{
+		writer.write_string(value);
+	}
+}
+
+void lib::string_table::read(binary_reader &reader)
+{
+	// Each string is at least prefixed by its length
+	const auto count = reader.read_count(4);
+
+	strings.clear();
+	indices.clear();
+	strings.reserve(count);
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		strings.push_back(reader.read_string());
+		indices[strings.back()] = i;
+	}
+}
+
+//endregion
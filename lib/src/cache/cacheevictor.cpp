@@ -0,0 +1,173 @@
+#include "lib/cache/cacheevictor.hpp"
+#include "lib/log.hpp"
+
+#include <algorithm>
+
+lib::cache_evictor::cache_evictor(ghc::filesystem::path directory, size_t max_size,
+	std::chrono::milliseconds interval)
+	: directory(std::move(directory)),
+	interval(interval),
+	max_size(max_size)
+{
+	if (interval.count() > 0)
+	{
+		thread = std::thread(&cache_evictor::run, this);
+	}
+}
+
+lib::cache_evictor::~cache_evictor()
+{
+	if (!thread.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopped = true;
+	}
+
+	condition.notify_one();
+	thread.join();
+}
+
+auto lib::cache_evictor::evict() -> stats
+{
+	struct entry
+	{
+		ghc::filesystem::path path;
+		ghc::filesystem::file_time_type last_used;
+		size_t size;
+	};
+
+	std::vector<entry> entries;
+	size_t size = 0;
+
+	std::error_code error;
+	for (ghc::filesystem::directory_iterator iter(directory, error), end;
+		!error && iter != end; iter.increment(error))
+	{
+		std::error_code entry_error;
+		if (!iter->is_regular_file(entry_error))
+		{
+			continue;
+		}
+
+		entry file;
+		file.path = iter->path();
+		file.size = static_cast<size_t>(iter->file_size(entry_error));
+		file.last_used = iter->last_write_time(entry_error);
+		if (entry_error)
+		{
+			continue;
+		}
+
+		size += file.size;
+		entries.push_back(file);
+	}
+
+	size_t limit;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		limit = max_size;
+	}
+
+	size_t evicted_files = 0;
+	size_t evicted_bytes = 0;
+
+	if (limit > 0 && size > limit)
+	{
+		std::sort(entries.begin(), entries.end(), [](const entry &entry1, const entry &entry2)
+		{
+			return entry1.last_used < entry2.last_used;
+		});
+
+		const auto target = limit / 100 * low_watermark;
+		for (const auto &file: entries)
+		{
+			if (size <= target)
+			{
+				break;
+			}
+
+			if (!ghc::filesystem::remove(file.path, error))
+			{
+				continue;
+			}
+
+			size -= file.size;
+			evicted_files++;
+			evicted_bytes += file.size;
+		}
+
+		lib::log::debug("Removed {} files ({} bytes) from {}",
+			evicted_files, evicted_bytes, directory.string());
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	current_stats.size = size;
+	current_stats.files = entries.size() - evicted_files;
+	current_stats.evicted_files += evicted_files;
+	current_stats.evicted_bytes += evicted_bytes;
+	return current_stats;
+}
+
+auto lib::cache_evictor::get_stats() const -> stats
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return current_stats;
+}
+
+auto lib::cache_evictor::get_max_size() const -> size_t
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return max_size;
+}
+
+void lib::cache_evictor::set_max_size(size_t size)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		max_size = size;
+	}
+
+	// Check new limit right away
+	condition.notify_one();
+}
+
+void lib::cache_evictor::touch(const ghc::filesystem::path &path)
+{
+	std::error_code error;
+	ghc::filesystem::last_write_time(path,
+		ghc::filesystem::file_time_type::clock::now(), error);
+}
+
+void lib::cache_evictor::run()
+{
+	while (true)
+	{
+		evict();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		const auto size = max_size;
+		condition.wait_for(lock, interval, [this, size]() -> bool
+		{
+			return stopped || max_size != size;
+		});
+
+		if (stopped)
+		{
+			return;
+		}
+	}
+}
+
+void lib::to_json(nlohmann::json &j, const cache_evictor::stats &stats)
+{
+	j = nlohmann::json{
+		{"size", stats.size},
+		{"files", stats.files},
+		{"evicted_files", stats.evicted_files},
+		{"evicted_bytes", stats.evicted_bytes},
+	};
+}
@@ -0,0 +1,199 @@
+#include "lib/cache/databasecache.hpp"
+#include "lib/cache/binarycache.hpp"
+
+lib::database_cache::database_cache(const lib::paths &paths)
+	: json_cache(paths),
+	store(dir("") / "cache.db", max_pending)
+{
+}
+
+//region album
+
+auto lib::database_cache::get_album(const std::string &album_id) const -> lib::spt::album
+{
+	return get_json(key("album", album_id));
+}
+
+void lib::database_cache::set_album(const lib::spt::album &album)
+{
+	set_json(key("album", album.id), album);
+}
+
+//endregion
+
+//region playlists
+
+auto lib::database_cache::get_playlists() const -> std::vector<lib::spt::playlist>
+{
+	const auto json = get_json("playlists");
+	if (json.is_null())
+	{
+		return {};
+	}
+	return json;
+}
+
+void lib::database_cache::set_playlists(const std::vector<spt::playlist> &playlists)
+{
+	set_json("playlists", playlists);
+}
+
+//endregion
+
+//region playlist
+
+auto lib::database_cache::get_playlist(const std::string &playlist_id) const -> lib::spt::playlist
+{
+	return get_json(key("playlist", playlist_id));
+}
+
+void lib::database_cache::set_playlist(const spt::playlist &playlist)
+{
+	set_json(key("playlist", playlist.id), playlist);
+	update_playlist_index(playlist);
+}
+
+//endregion
+
+//region tracks
+
+auto lib::database_cache::get_tracks(const std::string &entity_id) const
+-> std::vector<lib::spt::track>
+{
+	const auto data = store.get(key("tracks", entity_id));
+	if (data.empty())
+	{
+		return {};
+	}
+	return binary_cache::deserialize(data);
+}
+
+void lib::database_cache::set_tracks(const std::string &entity_id,
+	const std::vector<lib::spt::track> &tracks)
+{
+	store.put(key("tracks", entity_id), binary_cache::serialize(tracks));
+}
+
+auto lib::database_cache::all_tracks() const -> std::map<std::string, std::vector<lib::spt::track>>
+{
+	const auto prefix = key("tracks", std::string());
+	std::map<std::string, std::vector<lib::spt::track>> results;
+
+	for (const auto &item: store.keys(prefix))
+	{
+		results[item.substr(prefix.size())] = binary_cache::deserialize(store.get(item));
+	}
+
+	return results;
+}
+
+//endregion
+
+//region track info
+
+auto lib::database_cache::get_track_info(const lib::spt::track &track) const
+-> lib::spt::track_info
+{
+	return get_json(key("track_info", track.id));
+}
+
+void lib::database_cache::set_track_info(const lib::spt::track &track,
+	const lib::spt::track_info &track_info)
+{
+	set_json(key("track_info", track.id), track_info);
+}
+
+//endregion
+
+//region crash
+
+void lib::database_cache::add_crash(const lib::crash_info &info)
+{
+	auto name = lib::date_time::now().to_iso_date_time();
+	set_json(key("crash", name), info);
+
+	// Application is most likely about to exit
+	commit();
+}
+
+auto lib::database_cache::get_all_crashes() const -> std::vector<lib::crash_info>
+{
+	std::vector<lib::crash_info> results;
+
+	for (const auto &item: store.keys(key("crash", std::string())))
+	{
+		results.push_back(get_json(item));
+	}
+
+	return results;
+}
+
+//endregion
+
+void lib::database_cache::commit()
+{
+	store.commit();
+}
+
+//region protected
+
+auto lib::database_cache::load_playlist_index() const -> lib::playlist_index
+{
+	const auto json = get_json("playlist_index");
+	if (!json.is_null())
+	{
+		return json;
+	}
+
+	// Index created from playlists cached before it was added
+	lib::playlist_index index;
+	for (const auto &item: store.keys(key("playlist", std::string())))
+	{
+		index.update(get_json(item));
+	}
+
+	store.put("playlist_index", nlohmann::json::to_cbor(index));
+	return index;
+}
+
+void lib::database_cache::save_playlist_index(const lib::playlist_index &index)
+{
+	set_json("playlist_index", index);
+}
+
+//endregion
+
+//region private
+
+auto lib::database_cache::key(const std::string &type,
+	const std::string &entity_id) -> std::string
+{
+	return lib::fmt::format("{}/{}", type, entity_id);
+}
+
+auto lib::database_cache::get_json(const std::string &key) const -> nlohmann::json
+{
+	const auto data = store.get(key);
+	if (data.empty())
+	{
+		return {};
+	}
+
+	try
+	{
+		return nlohmann::json::from_cbor(data);
+	}
+	catch (const std::exception &e)
+	{
+		lib::log::warn("Failed to load \"{}\" from cache: {}", key, e.what());
+	}
+
+	return {};
+}
+
+void lib::database_cache::set_json(const std::string &key, const nlohmann::json &json)
+{
+	store.put(key, nlohmann::json::to_cbor(json));
+}
+
+//endregion
@@ -1,5 +1,5 @@
-
 #include "lib/cache/jsoncache.hpp"
+#include "lib/cache/cacheevictor.hpp"
 
 lib::json_cache::json_cache(const lib::paths &paths)
 	: paths(paths)
@@ -10,12 +10,15 @@ lib::json_cache::json_cache(const lib::paths &paths)
 
 auto lib::json_cache::get_album_image(const std::string &url) const -> std::vector<unsigned char>
 {
-	std::ifstream file(get_album_image_path(url), std::ios::binary);
+	const auto file_path = get_album_image_path(url);
+	std::ifstream file(file_path, std::ios::binary);
 	if (!file.is_open() || file.bad())
 	{
 		return {};
 	}
 
+	lib::cache_evictor::touch(file_path);
+
 	return {
 		std::istreambuf_iterator<char>(file),
 		std::istreambuf_iterator<char>(),
@@ -99,6 +102,12 @@ auto lib::json_cache::get_playlist(const std::string &playlist_id) const -> lib:
 void lib::json_cache::set_playlist(const spt::playlist &playlist)
 {
 	lib::json::save(path("playlist", playlist.id, "json"), playlist);
+	update_playlist_index(playlist);
+}
+
+auto lib::json_cache::get_playlist_index() const -> const lib::playlist_index &
+{
+	return playlist_index();
 }
 
 //endregion
@@ -122,14 +131,9 @@ auto lib::json_cache::all_tracks() const -> std::map<std::string, std::vector<li
 	auto dir = paths.cache() / "tracks";
 	std::map<std::string, std::vector<lib::spt::track>> results;
 
-	if (!ghc::filesystem::exists(dir))
+	for (const auto &file: lib::json::list(dir))
 	{
-		return results;
-	}
-
-	for (const auto &entry: ghc::filesystem::directory_iterator(dir))
-	{
-		auto entity_id = entry.path().filename().replace_extension().string();
+		auto entity_id = file.stem().string();
 		results[entity_id] = get_tracks(entity_id);
 	}
 
@@ -158,7 +162,10 @@ void lib::json_cache::set_track_info(const lib::spt::track &track,
 void lib::json_cache::add_crash(const lib::crash_info &info)
 {
 	auto file_name = lib::date_time::now().to_iso_date_time();
-	lib::json::save(path("crash", file_name, "json"), info);
+
+	// Application is most likely about to exit, so write now
+	lib::write_queue::write_atomic(path("crash", file_name, "json"),
+		nlohmann::json(info).dump());
 }
 
 auto lib::json_cache::get_all_crashes() const -> std::vector<lib::crash_info>
@@ -166,14 +173,9 @@ auto lib::json_cache::get_all_crashes() const -> std::vector<lib::crash_info>
 	auto dir = ghc::filesystem::path(paths.cache()) / "crash";
 	std::vector<lib::crash_info> results;
 
-	if (!ghc::filesystem::exists(dir))
+	for (const auto &file: lib::json::list(dir))
 	{
-		return results;
-	}
-
-	for (const auto &entry: ghc::filesystem::directory_iterator(dir))
-	{
-		results.push_back(lib::json::load<lib::crash_info>(entry.path()));
+		results.push_back(lib::json::load<lib::crash_info>(file));
 	}
 
 	return results;
@@ -209,6 +211,56 @@ auto lib::json_cache::path(const std::string &type, const std::string &entity_id
 	return (dir(type) / file(entity_id, extension)).string();
 }
 
+void lib::json_cache::update_playlist_index(const spt::playlist &playlist)
+{
+	auto &index = playlist_index();
+	index.update(playlist);
+	save_playlist_index(index);
+}
+
+auto lib::json_cache::load_playlist_index() const -> lib::playlist_index
+{
+	const auto index_path = ghc::filesystem::path(paths.cache()) / "playlist"
+		/ file("index", "json");
+
+	const auto json = lib::json::load(index_path);
+	if (!json.is_null())
+	{
+		return json.get<lib::playlist_index>();
+	}
+
+	// Index created from playlists cached before it was added
+	lib::playlist_index index;
+
+	for (const auto &file: lib::json::list(index_path.parent_path()))
+	{
+		const auto playlist_id = file.stem().string();
+		if (playlist_id != "playlists" && playlist_id != "index")
+		{
+			index.update(get_playlist(playlist_id));
+		}
+	}
+
+	lib::json::save(path("playlist", "index", "json"), index);
+	return index;
+}
+
+void lib::json_cache::save_playlist_index(const lib::playlist_index &index)
+{
+	lib::json::save(path("playlist", "index", "json"), index);
+}
+
+auto lib::json_cache::playlist_index() const -> lib::playlist_index &
+{
+	if (!has_playlist_index)
+	{
+		cached_playlist_index = load_playlist_index();
+		has_playlist_index = true;
+	}
+
+	return cached_playlist_index;
+}
+
 auto lib::json_cache::get_url_id(const ghc::filesystem::path &path) -> std::string
 {
 	return path.stem().string();
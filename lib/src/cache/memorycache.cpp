@@ -0,0 +1,395 @@
+#include "lib/cache/memorycache.hpp"
+
+lib::memory_cache::memory_cache(std::unique_ptr<lib::cache> cache, size_t max_size,
+	std::chrono::milliseconds write_delay)
+	: cache(std::move(cache)),
+	write_delay(write_delay),
+	albums(max_size),
+	playlists(max_size),
+	tracks(max_size)
+{
+	thread = std::thread(&memory_cache::run, this);
+}
+
+lib::memory_cache::~memory_cache()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	condition.notify_one();
+	thread.join();
+}
+
+//region album
+
+auto lib::memory_cache::get_album_image(const std::string &url) const
+-> std::vector<unsigned char>
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	return cache->get_album_image(url);
+}
+
+auto lib::memory_cache::get_album_image_path(const std::string &url) const -> std::string
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	return cache->get_album_image_path(url);
+}
+
+void lib::memory_cache::set_album_image(const std::string &url,
+	const std::vector<unsigned char> &data)
+{
+	// Image is usually requested as a file directly after
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	cache->set_album_image(url, data);
+}
+
+auto lib::memory_cache::get_album(const std::string &album_id) const -> lib::spt::album
+{
+	return get<lib::spt::album>(albums, lib::fmt::format("album/{}", album_id),
+		[&album_id](const lib::cache &cache) -> lib::spt::album
+		{
+			return cache.get_album(album_id);
+		}, [](const lib::spt::album &/*album*/) -> size_t
+		{
+			return 1;
+		});
+}
+
+void lib::memory_cache::set_album(const lib::spt::album &album)
+{
+	const auto key = lib::fmt::format("album/{}", album.id);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		albums.put(key, album, 1);
+	}
+
+	write(key, [album](lib::cache &cache)
+	{
+		cache.set_album(album);
+	});
+}
+
+//endregion
+
+//region playlists
+
+auto lib::memory_cache::get_playlists() const -> std::vector<lib::spt::playlist>
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (has_all_playlists)
+		{
+			return all_playlists;
+		}
+	}
+
+	wait_for_write("playlists");
+
+	std::lock_guard<std::mutex> cache_lock(cache_mutex);
+	write_now("playlists");
+	auto items = cache->get_playlists();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!has_all_playlists)
+	{
+		all_playlists = items;
+		has_all_playlists = true;
+	}
+	return all_playlists;
+}
+
+void lib::memory_cache::set_playlists(const std::vector<spt::playlist> &items)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		all_playlists = items;
+		has_all_playlists = true;
+	}
+
+	write("playlists", [items](lib::cache &cache)
+	{
+		cache.set_playlists(items);
+	});
+
+	if (playlists_listener)
+	{
+		playlists_listener(items);
+	}
+}
+
+//endregion
+
+//region playlist
+
+auto lib::memory_cache::get_playlist(const std::string &playlist_id) const -> lib::spt::playlist
+{
+	return get<lib::spt::playlist>(playlists, lib::fmt::format("playlist/{}", playlist_id),
+		[&playlist_id](const lib::cache &cache) -> lib::spt::playlist
+		{
+			return cache.get_playlist(playlist_id);
+		}, [](const lib::spt::playlist &playlist) -> size_t
+		{
+			return playlist.tracks.size() + 1;
+		});
+}
+
+void lib::memory_cache::set_playlist(const spt::playlist &playlist)
+{
+	const auto key = lib::fmt::format("playlist/{}", playlist.id);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		playlists.put(key, playlist, playlist.tracks.size() + 1);
+		if (has_playlist_index)
+		{
+			playlist_index.update(playlist);
+		}
+	}
+
+	write(key, [playlist](lib::cache &cache)
+	{
+		cache.set_playlist(playlist);
+	});
+
+	if (playlist_listener)
+	{
+		playlist_listener(playlist);
+	}
+}
+
+auto lib::memory_cache::get_playlist_index() const -> const lib::playlist_index &
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (has_playlist_index)
+		{
+			return playlist_index;
+		}
+	}
+
+	// Pending playlists need to be in index when loading it
+	flush();
+
+	std::lock_guard<std::mutex> cache_lock(cache_mutex);
+	const auto &index = cache->get_playlist_index();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	playlist_index = index;
+	has_playlist_index = true;
+	return playlist_index;
+}
+
+//endregion
+
+//region tracks
+
+auto lib::memory_cache::get_tracks(const std::string &entity_id) const
+-> std::vector<lib::spt::track>
+{
+	return get<std::vector<lib::spt::track>>(tracks, lib::fmt::format("tracks/{}", entity_id),
+		[&entity_id](const lib::cache &cache) -> std::vector<lib::spt::track>
+		{
+			return cache.get_tracks(entity_id);
+		}, [](const std::vector<lib::spt::track> &items) -> size_t
+		{
+			return items.size() + 1;
+		});
+}
+
+void lib::memory_cache::set_tracks(const std::string &entity_id,
+	const std::vector<lib::spt::track> &items)
+{
+	const auto key = lib::fmt::format("tracks/{}", entity_id);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tracks.put(key, items, items.size() + 1);
+	}
+
+	write(key, [entity_id, items](lib::cache &cache)
+	{
+		cache.set_tracks(entity_id, items);
+	});
+
+	if (tracks_listener)
+	{
+		tracks_listener(entity_id, items);
+	}
+}
+
+auto lib::memory_cache::all_tracks() const -> std::map<std::string, std::vector<lib::spt::track>>
+{
+	flush();
+
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	return cache->all_tracks();
+}
+
+//endregion
+
+//region track info
+
+auto lib::memory_cache::get_track_info(const lib::spt::track &track) const
+-> lib::spt::track_info
+{
+	const auto key = lib::fmt::format("track_info/{}", track.id);
+	wait_for_write(key);
+
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	write_now(key);
+	return cache->get_track_info(track);
+}
+
+void lib::memory_cache::set_track_info(const lib::spt::track &track,
+	const lib::spt::track_info &track_info)
+{
+	write(lib::fmt::format("track_info/{}", track.id), [track, track_info](lib::cache &cache)
+	{
+		cache.set_track_info(track, track_info);
+	});
+}
+
+//endregion
+
+//region crash
+
+void lib::memory_cache::add_crash(const lib::crash_info &info)
+{
+	// Called when crashing, possibly while writing in the background,
+	// so don't wait for, or write, other changes
+	std::unique_lock<std::mutex> lock(cache_mutex, std::try_to_lock);
+	if (!lock.owns_lock())
+	{
+		return;
+	}
+
+	cache->add_crash(info);
+}
+
+auto lib::memory_cache::get_all_crashes() const -> std::vector<lib::crash_info>
+{
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	return cache->get_all_crashes();
+}
+
+//endregion
+
+void lib::memory_cache::flush() const
+{
+	std::map<std::string, write_function> changes;
+	{
+		// Wait for changes already being written
+		std::unique_lock<std::mutex> lock(mutex);
+		written.wait(lock, [this]() -> bool
+		{
+			return writing.empty();
+		});
+
+		changes.swap(pending);
+		for (const auto &change: changes)
+		{
+			writing.insert(change.first);
+		}
+	}
+
+	// Only lock cache for each change, so it can still be read while writing
+	for (const auto &change: changes)
+	{
+		{
+			std::lock_guard<std::mutex> cache_lock(cache_mutex);
+			change.second(*cache);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			writing.erase(change.first);
+		}
+		written.notify_all();
+	}
+}
+
+void lib::memory_cache::on_playlists_changed(const std::function<void(
+	const std::vector<lib::spt::playlist> &playlists)> &listener)
+{
+	playlists_listener = listener;
+}
+
+void lib::memory_cache::on_playlist_changed(const std::function<void(
+	const lib::spt::playlist &playlist)> &listener)
+{
+	playlist_listener = listener;
+}
+
+void lib::memory_cache::on_tracks_changed(const std::function<void(const std::string &entity_id,
+	const std::vector<lib::spt::track> &tracks)> &listener)
+{
+	tracks_listener = listener;
+}
+
+//region private
+
+void lib::memory_cache::run()
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this]() -> bool
+			{
+				return stopping || !pending.empty();
+			});
+
+			// Wait for more changes to write at the same time
+			condition.wait_for(lock, write_delay, [this]() -> bool
+			{
+				return stopping;
+			});
+
+			if (stopping && pending.empty())
+			{
+				return;
+			}
+		}
+
+		flush();
+	}
+}
+
+void lib::memory_cache::write(const std::string &key, const write_function &function)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending[key] = function;
+	}
+
+	condition.notify_one();
+}
+
+void lib::memory_cache::wait_for_write(const std::string &key) const
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	written.wait(lock, [this, &key]() -> bool
+	{
+		return writing.find(key) == writing.end();
+	});
+}
+
+void lib::memory_cache::write_now(const std::string &key) const
+{
+	write_function function;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		const auto change = pending.find(key);
+		if (change == pending.end())
+		{
+			return;
+		}
+
+		function = change->second;
+		pending.erase(change);
+	}
+
+	function(*cache);
+}
+
+//endregion
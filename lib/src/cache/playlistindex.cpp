@@ -0,0 +1,115 @@
+#include "lib/cache/playlistindex.hpp"
+#include "lib/datetime.hpp"
+
+void lib::playlist_index::update(const lib::spt::playlist &playlist)
+{
+	// ISO dates are ordered the same as strings, so only the latest needs to be parsed
+	const lib::spt::track *latest = nullptr;
+	for (const auto &track: playlist.tracks)
+	{
+		if (!track.added_at.empty()
+			&& (latest == nullptr || track.added_at > latest->added_at))
+		{
+			latest = &track;
+		}
+	}
+
+	added[playlist.id] = latest == nullptr
+		? 0
+		: lib::date_time::parse(latest->added_at).to_epoch();
+
+	std::unordered_set<std::string> names;
+	for (const auto &track: playlist.tracks)
+	{
+		for (const auto &artist: track.artists)
+		{
+			names.insert(artist.name);
+		}
+	}
+
+	set_artists(playlist.id, std::vector<std::string>(names.cbegin(), names.cend()));
+}
+
+void lib::playlist_index::set_artists(const std::string &playlist_id,
+	const std::vector<std::string> &names)
+{
+	for (const auto &name: artists[playlist_id])
+	{
+		auto item = playlists.find(name);
+		if (item == playlists.end())
+		{
+			continue;
+		}
+
+		item->second.erase(playlist_id);
+		if (item->second.empty())
+		{
+			playlists.erase(item);
+		}
+	}
+
+	for (const auto &name: names)
+	{
+		playlists[name].insert(playlist_id);
+	}
+
+	artists[playlist_id] = names;
+}
+
+auto lib::playlist_index::latest_added(const std::string &playlist_id) const -> long long
+{
+	const auto item = added.find(playlist_id);
+	return item == added.end()
+		? 0
+		: item->second;
+}
+
+auto lib::playlist_index::has_artist(const std::string &artist_name) const -> bool
+{
+	return playlists.find(artist_name) != playlists.end();
+}
+
+auto lib::playlist_index::artist_playlists(const std::string &artist_name) const
+-> std::vector<std::string>
+{
+	const auto item = playlists.find(artist_name);
+	if (item == playlists.end())
+	{
+		return {};
+	}
+
+	return {
+		item->second.cbegin(),
+		item->second.cend(),
+	};
+}
+
+auto lib::playlist_index::size() const -> size_t
+{
+	return added.size();
+}
+
+void lib::to_json(nlohmann::json &j, const playlist_index &index)
+{
+	j = nlohmann::json{
+		{"added", index.added},
+		{"artists", index.artists},
+	};
+}
+
+void lib::from_json(const nlohmann::json &j, playlist_index &index)
+{
+	if (!j.is_object())
+	{
+		return;
+	}
+
+	lib::json::get(j, "added", index.added);
+
+	std::unordered_map<std::string, std::vector<std::string>> artists;
+	lib::json::get(j, "artists", artists);
+	for (const auto &item: artists)
+	{
+		index.set_artists(item.first, item.second);
+	}
+}
@@ -0,0 +1,352 @@
+#include "lib/cache/recordstore.hpp"
+#include "lib/cache/binaryformat.hpp"
+#include "lib/log.hpp"
+
+#include <algorithm>
+
+// Identifies file as a record store, "SQTD" in little-endian
+constexpr uint32_t store_magic = 0x44545153;
+constexpr uint32_t store_version = 1;
+constexpr size_t store_header_size = 8;
+
+// Only compact if there's at least this much unused data
+constexpr uint64_t min_compact_size = 1024 * 1024;
+
+lib::record_store::record_store(const ghc::filesystem::path &path, size_t max_pending)
+	: path(path),
+	max_pending(max_pending)
+{
+	open();
+
+	if (file_size - live_size > min_compact_size && file_size - live_size > live_size)
+	{
+		compact();
+	}
+}
+
+lib::record_store::~record_store()
+{
+	commit();
+}
+
+auto lib::record_store::get(const std::string &key) const -> std::vector<unsigned char>
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	const auto change = pending.find(key);
+	if (change != pending.end())
+	{
+		return change->second;
+	}
+
+	const auto item = index.find(key);
+	if (item == index.end())
+	{
+		return {};
+	}
+
+	auto value = read(item->second);
+	if (checksum(key, value) != item->second.checksum)
+	{
+		lib::log::warn("Failed to load \"{}\" from cache: invalid checksum", key);
+		return {};
+	}
+
+	return value;
+}
+
+void lib::record_store::put(const std::string &key, const std::vector<unsigned char> &value)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	pending[key] = value;
+	if (pending.size() >= max_pending)
+	{
+		write_pending();
+	}
+}
+
+auto lib::record_store::keys(const std::string &prefix) const -> std::vector<std::string>
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::vector<std::string> results;
+
+	// Index and pending changes are both sorted, so matching keys are next to each other
+	for (auto item = index.lower_bound(prefix); item != index.end()
+		&& item->first.compare(0, prefix.size(), prefix) == 0; item++)
+	{
+		results.push_back(item->first);
+	}
+
+	for (auto item = pending.lower_bound(prefix); item != pending.end()
+		&& item->first.compare(0, prefix.size(), prefix) == 0; item++)
+	{
+		if (index.find(item->first) == index.end())
+		{
+			results.push_back(item->first);
+		}
+	}
+
+	std::sort(results.begin(), results.end());
+	return results;
+}
+
+void lib::record_store::commit()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	write_pending();
+}
+
+void lib::record_store::open()
+{
+	index.clear();
+	live_size = 0;
+
+	if (!ghc::filesystem::exists(path))
+	{
+		binary_writer header;
+		header.write_u32(store_magic);
+		header.write_u32(store_version);
+
+		std::ofstream out(path.string(), std::ios::binary);
+		out.write(reinterpret_cast<const char *>(header.data().data()),
+			static_cast<std::streamsize>(header.data().size()));
+	}
+
+	file.open(path.string(), std::ios::in | std::ios::out | std::ios::binary);
+	if (!file.is_open())
+	{
+		lib::log::error("Failed to open cache: {}", path.string());
+		return;
+	}
+
+	file_size = ghc::filesystem::file_size(path);
+
+	std::vector<unsigned char> header(store_header_size);
+	file.read(reinterpret_cast<char *>(header.data()),
+		static_cast<std::streamsize>(header.size()));
+
+	binary_reader header_reader(header);
+	if (!file || header_reader.read_u32() != store_magic
+		|| header_reader.read_u32() != store_version)
+	{
+		lib::log::warn("Cache is invalid or outdated, clearing");
+		file.close();
+		ghc::filesystem::remove(path);
+		open();
+		return;
+	}
+
+	// Only headers and keys are read, values are read when requested
+	uint64_t offset = store_header_size;
+	std::vector<unsigned char> record_header(header_size);
+
+	while (offset + header_size <= file_size)
+	{
+		file.seekg(static_cast<std::streamoff>(offset));
+		file.read(reinterpret_cast<char *>(record_header.data()),
+			static_cast<std::streamsize>(record_header.size()));
+
+		binary_reader reader(record_header);
+		const auto key_size = reader.read_u32();
+		const auto value_size = reader.read_u32();
+		const auto value_checksum = reader.read_u32();
+
+		const auto record_size = header_size + key_size + value_size;
+		if (!file || offset + record_size > file_size)
+		{
+			break;
+		}
+
+		std::string key(key_size, '\0');
+		file.read(&key[0], static_cast<std::streamsize>(key_size));
+
+		auto previous = index.find(key);
+		if (previous != index.end())
+		{
+			live_size -= header_size + key_size + previous->second.size;
+		}
+
+		index[key] = location{
+			offset + header_size + key_size,
+			value_size,
+			value_checksum,
+		};
+
+		live_size += record_size;
+		offset += record_size;
+	}
+
+	file.clear();
+
+	if (offset < file_size)
+	{
+		// Last record was only partially written
+		lib::log::warn("Cache has incomplete data, discarding {} bytes", file_size - offset);
+		file.close();
+		ghc::filesystem::resize_file(path, offset);
+		file.open(path.string(), std::ios::in | std::ios::out | std::ios::binary);
+		file_size = offset;
+	}
+}
+
+void lib::record_store::compact()
+{
+	const auto temp_path = ghc::filesystem::path(path.string() + ".tmp");
+
+	{
+		std::ofstream out(temp_path.string(), std::ios::binary | std::ios::trunc);
+
+		binary_writer header;
+		header.write_u32(store_magic);
+		header.write_u32(store_version);
+		out.write(reinterpret_cast<const char *>(header.data().data()),
+			static_cast<std::streamsize>(header.data().size()));
+
+		for (const auto &item: index)
+		{
+			// Drop invalid records, instead of saving them with a new checksum
+			const auto value = read(item.second);
+			if (value.size() != item.second.size
+				|| checksum(item.first, value) != item.second.checksum)
+			{
+				lib::log::warn("Removing \"{}\" from cache: invalid checksum", item.first);
+				continue;
+			}
+
+			const auto data = record(item.first, value);
+			out.write(reinterpret_cast<const char *>(data.data()),
+				static_cast<std::streamsize>(data.size()));
+		}
+
+		if (!out)
+		{
+			lib::log::warn("Failed to compact cache");
+			out.close();
+
+			std::error_code error;
+			ghc::filesystem::remove(temp_path, error);
+			return;
+		}
+	}
+
+	file.close();
+
+	std::error_code error;
+	ghc::filesystem::rename(temp_path, path, error);
+	if (error)
+	{
+		lib::log::warn("Failed to compact cache: {}", error.message());
+	}
+
+	open();
+}
+
+void lib::record_store::write_pending()
+{
+	if (pending.empty() || !file.is_open())
+	{
+		return;
+	}
+
+	std::vector<unsigned char> data;
+	std::map<std::string, location> locations;
+
+	for (const auto &change: pending)
+	{
+		const auto &key = change.first;
+		const auto &value = change.second;
+
+		locations[key] = location{
+			file_size + data.size() + header_size + key.size(),
+			static_cast<uint32_t>(value.size()),
+			checksum(key, value),
+		};
+
+		const auto entry = record(key, value);
+		data.insert(data.end(), entry.cbegin(), entry.cend());
+	}
+
+	// All changes are appended in a single write
+	file.seekp(static_cast<std::streamoff>(file_size));
+	file.write(reinterpret_cast<const char *>(data.data()),
+		static_cast<std::streamsize>(data.size()));
+	file.flush();
+
+	// Keep changes pending, to try again on next commit
+	if (!file)
+	{
+		lib::log::warn("Failed to write {} changes to cache", pending.size());
+		file.clear();
+		return;
+	}
+
+	// Only point to new records once they're written
+	for (const auto &item: locations)
+	{
+		const auto &key = item.first;
+
+		auto previous = index.find(key);
+		if (previous != index.end())
+		{
+			live_size -= header_size + key.size() + previous->second.size;
+		}
+
+		index[key] = item.second;
+		live_size += header_size + key.size() + item.second.size;
+	}
+
+	file_size += data.size();
+	pending.clear();
+}
+
+auto lib::record_store::read(const location &loc) const -> std::vector<unsigned char>
+{
+	std::vector<unsigned char> value(loc.size);
+
+	file.seekg(static_cast<std::streamoff>(loc.offset));
+	file.read(reinterpret_cast<char *>(value.data()),
+		static_cast<std::streamsize>(value.size()));
+
+	if (!file)
+	{
+		file.clear();
+		return {};
+	}
+
+	return value;
+}
+
+auto lib::record_store::checksum(const std::string &key,
+	const std::vector<unsigned char> &value) -> uint32_t
+{
+	// 32-bit FNV-1a
+	constexpr uint32_t offset_basis = 2166136261U;
+	constexpr uint32_t prime = 16777619U;
+
+	auto hash = offset_basis;
+	for (const auto c: key)
+	{
+		hash = (hash ^ static_cast<unsigned char>(c)) * prime;
+	}
+	for (const auto c: value)
+	{
+		hash = (hash ^ c) * prime;
+	}
+
+	return hash;
+}
+
+auto lib::record_store::record(const std::string &key,
+	const std::vector<unsigned char> &value) -> std::vector<unsigned char>
+{
+	binary_writer writer;
+	writer.write_u32(static_cast<uint32_t>(key.size()));
+	writer.write_u32(static_cast<uint32_t>(value.size()));
+	writer.write_u32(checksum(key, value));
+
+	auto data = writer.data();
+	data.insert(data.end(), key.cbegin(), key.cend());
+	data.insert(data.end(), value.cbegin(), value.cend());
+	return data;
+}
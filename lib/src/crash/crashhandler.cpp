@@ -1,5 +1,7 @@
 #include "lib/crash/crashhandler.hpp"
 
+#include <cstdlib>
+
 lib::cache *lib::crash_handler::cache = nullptr;
 
 bool lib::crash_handler::initialized = false;
@@ -79,6 +81,8 @@ void lib::crash_handler::handle(int signal, struct sigcontext context)
 	}
 
 	log(info);
-	exit(signal);
+
+	// Background threads may have crashed, so exit without waiting for them
+	std::_Exit(signal);
 }
 #endif
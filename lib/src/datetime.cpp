@@ -46,10 +46,20 @@ auto lib::date_time::parse(const std::string &value) -> lib::date_time
 }
 
 auto lib::date_time::now() -> lib::date_time
+{
+	return local(std::time(nullptr));
+}
+
+auto lib::date_time::local(std::time_t time) -> lib::date_time
 {
 	lib::date_time date;
-	auto time = std::time(nullptr);
-	date.tm = *std::localtime(&time);
+
+	// Also called from background threads, so avoid the shared buffer of localtime
+#ifdef _WIN32
+	localtime_s(&date.tm, &time);
+#else
+	localtime_r(&time, &date.tm);
+#endif
 
 	return date;
 }
@@ -58,7 +68,12 @@ auto lib::date_time::now_utc() -> lib::date_time
 {
 	lib::date_time date;
 	auto time = std::time(nullptr);
-	date.tm = *std::gmtime(&time);
+
+#ifdef _WIN32
+	gmtime_s(&date.tm, &time);
+#else
+	gmtime_r(&time, &date.tm);
+#endif
 
 	return date;
 }
@@ -117,6 +132,29 @@ auto lib::date_time::format(const char *format) const -> std::string
 	return std::string(buffer.data());
 }
 
+auto lib::date_time::to_epoch() const -> long long
+{
+	if (!is_valid())
+	{
+		return 0;
+	}
+
+	// Days from civil, as std::mktime uses local time
+	constexpr long long days_in_era = 146097;
+	constexpr long long seconds_in_day = 86400;
+	constexpr long long days_to_epoch = 719468;
+
+	const long long year = get_year() - (get_month() <= 2 ? 1 : 0);
+	const long long month = get_month();
+	const long long era = (year >= 0 ? year : year - 399) / 400;
+	const auto year_of_era = year - era * 400;
+	const auto day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + get_day() - 1;
+	const auto day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+	const auto days = era * days_in_era + day_of_era - days_to_epoch;
+
+	return days * seconds_in_day + get_hour() * 3600LL + get_minute() * 60LL + get_second();
+}
+
 auto lib::date_time::get_second() const -> int
 {
 	return is_valid()
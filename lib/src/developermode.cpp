@@ -1,3 +1,3 @@
 #include "lib/developermode.hpp"
 
-bool lib::developer_mode::enabled = false;
+std::atomic<bool> lib::developer_mode::enabled(false);
@@ -0,0 +1,174 @@
+#include "lib/httpcache.hpp"
+#include "lib/strings.hpp"
+
+#include <algorithm>
+
+lib::http_cache::http_cache(size_t max_size)
+	: entries(max_size)
+{
+}
+
+auto lib::http_cache::get_fresh(const std::string &url, nlohmann::json &json) -> bool
+{
+	const auto *cached = entries.get(url);
+	if (cached == nullptr
+		|| cached->generation != generation
+		|| cached->expires <= clock::now())
+	{
+		return false;
+	}
+
+	current_stats.fresh++;
+	current_stats.saved_bytes += cached->size;
+	json = cached->json;
+	return true;
+}
+
+void lib::http_cache::add_headers(const std::string &url, lib::headers &headers)
+{
+	const auto *cached = entries.get(url);
+	if (cached != nullptr && !cached->etag.empty())
+	{
+		headers["If-None-Match"] = cached->etag;
+	}
+}
+
+auto lib::http_cache::get_not_modified(const std::string &url,
+	const lib::http_response &response, nlohmann::json &json) -> bool
+{
+	constexpr int status_not_modified = 304;
+
+	if (response.status != status_not_modified)
+	{
+		return false;
+	}
+
+	const auto *cached = entries.get(url);
+	if (cached == nullptr)
+	{
+		return false;
+	}
+
+	current_stats.revalidated++;
+	current_stats.saved_bytes += cached->size;
+	json = cached->json;
+
+	// Response is fresh again
+	set(url, response, json);
+	return true;
+}
+
+void lib::http_cache::set(const std::string &url, const lib::http_response &response,
+	const nlohmann::json &json)
+{
+	constexpr int status_ok = 200;
+	constexpr int status_not_modified = 304;
+
+	if (response.status != status_ok && response.status != status_not_modified)
+	{
+		entries.remove(url);
+		return;
+	}
+
+	const auto age = max_age(response.headers);
+	auto etag = header(response.headers, "etag");
+
+	// 304 responses may leave out the ETag, but it's still the same
+	const auto *cached = entries.get(url);
+	if (etag.empty() && cached != nullptr)
+	{
+		etag = cached->etag;
+	}
+
+	const auto size = response.body.empty() && cached != nullptr
+		? cached->size
+		: response.body.size();
+
+	if (age < 0 || (age == 0 && etag.empty()))
+	{
+		entries.remove(url);
+		return;
+	}
+
+	if (!response.body.empty())
+	{
+		current_stats.misses++;
+	}
+
+	entries.put(url, entry{
+		etag,
+		clock::now() + std::chrono::seconds(age),
+		generation,
+		size,
+		json,
+	}, size);
+}
+
+void lib::http_cache::expire()
+{
+	generation++;
+}
+
+void lib::http_cache::remove(const std::string &url)
+{
+	entries.remove(url);
+}
+
+void lib::http_cache::clear()
+{
+	entries.clear();
+}
+
+auto lib::http_cache::get_stats() const -> const stats &
+{
+	return current_stats;
+}
+
+auto lib::http_cache::max_age(const lib::headers &headers) -> int
+{
+	const std::string max_age_prefix = "max-age=";
+	const auto cache_control = lib::strings::to_lower(header(headers, "cache-control"));
+	auto age = 0;
+
+	for (auto directive: lib::strings::split(cache_control, ','))
+	{
+		lib::strings::trim(directive);
+
+		if (directive == "no-store")
+		{
+			return -1;
+		}
+
+		if (directive == "no-cache")
+		{
+			return 0;
+		}
+
+		if (lib::strings::starts_with(directive, max_age_prefix)
+			&& !lib::strings::try_to_int(directive.substr(max_age_prefix.size()), age))
+		{
+			age = 0;
+		}
+	}
+
+	return std::max(age, 0);
+}
+
+auto lib::http_cache::header(const lib::headers &headers,
+	const std::string &name) -> std::string
+{
+	const auto iter = headers.find(name);
+	return iter == headers.end()
+		? std::string()
+		: iter->second;
+}
+
+void lib::to_json(nlohmann::json &j, const http_cache::stats &stats)
+{
+	j = nlohmann::json{
+		{"fresh", stats.fresh},
+		{"revalidated", stats.revalidated},
+		{"misses", stats.misses},
+		{"saved_bytes", stats.saved_bytes},
+	};
+}
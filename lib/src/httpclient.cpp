@@ -5,3 +5,17 @@ void lib::http_client::post(const std::string &url, const lib::headers &headers,
 {
 	post(url, std::string(), headers, callback);
 }
+
+void lib::http_client::get_response(const std::string &url, const lib::headers &headers,
+	lib::callback<http_response> &callback) const
+{
+	get(url, headers, [callback](const std::string &body)
+	{
+		constexpr int status_ok = 200;
+
+		lib::http_response response;
+		response.status = status_ok;
+		response.body = body;
+		callback(response);
+	});
+}
@@ -0,0 +1,113 @@
+#include "lib/imageloader.hpp"
+#include "lib/image.hpp"
+#include "lib/uri.hpp"
+
+lib::image_loader::image_loader(const lib::http_client &http_client, lib::cache &cache,
+	size_t max_requests_per_host)
+	: http_client(http_client),
+	cache(cache),
+	max_requests_per_host(max_requests_per_host > 0 ? max_requests_per_host : 1)
+{
+}
+
+void lib::image_loader::get(const std::string &url,
+	lib::callback<std::vector<unsigned char>> &callback)
+{
+	const auto cached = cache.get_album_image(url);
+	if (lib::image::is_jpeg(cached))
+	{
+		current_stats.hits++;
+		callback(cached);
+		return;
+	}
+
+	auto request = pending.find(url);
+	if (request != pending.end())
+	{
+		current_stats.deduplicated++;
+		request->second.push_back(callback);
+		return;
+	}
+
+	current_stats.misses++;
+	pending[url].push_back(callback);
+
+	const auto url_host = host(url);
+	if (active[url_host] >= max_requests_per_host)
+	{
+		queued[url_host].push_back(url);
+		return;
+	}
+
+	download(url);
+}
+
+auto lib::image_loader::is_cached(const std::string &url) const -> bool
+{
+	return lib::image::is_jpeg(cache.get_album_image(url));
+}
+
+auto lib::image_loader::get_stats() const -> const stats &
+{
+	return current_stats;
+}
+
+void lib::image_loader::download(const std::string &url)
+{
+	active[host(url)]++;
+
+	http_client.get(url, lib::headers(), [this, url](const std::string &data)
+	{
+		downloaded(url, data);
+	});
+}
+
+void lib::image_loader::downloaded(const std::string &url, const std::string &data)
+{
+	const auto url_host = host(url);
+	active[url_host]--;
+
+	std::vector<unsigned char> image(data.cbegin(), data.cend());
+	if (lib::image::is_jpeg(image))
+	{
+		cache.set_album_image(url, image);
+	}
+	else
+	{
+		lib::log::warn("Album art from \"{}\" is not a valid JPEG image", url);
+		current_stats.failed++;
+		image.clear();
+	}
+
+	// Callbacks may request more images
+	const auto callbacks = std::move(pending[url]);
+	pending.erase(url);
+
+	auto &waiting = queued[url_host];
+	if (!waiting.empty())
+	{
+		const auto next = waiting.front();
+		waiting.pop_front();
+		download(next);
+	}
+
+	for (const auto &callback: callbacks)
+	{
+		callback(image);
+	}
+}
+
+auto lib::image_loader::host(const std::string &url) -> std::string
+{
+	return lib::uri(url).hostname();
+}
+
+void lib::to_json(nlohmann::json &j, const image_loader::stats &stats)
+{
+	j = nlohmann::json{
+		{"hits", stats.hits},
+		{"misses", stats.misses},
+		{"deduplicated", stats.deduplicated},
+		{"failed", stats.failed},
+	};
+}
@@ -1,5 +1,7 @@
 #include "lib/json.hpp"
 
+#include <set>
+
 auto lib::json::combine(const nlohmann::json &item1, const nlohmann::json &item2) -> nlohmann::json
 {
 	auto item = nlohmann::json::array();
@@ -18,6 +20,23 @@ auto lib::json::combine(const nlohmann::json &item1, const nlohmann::json &item2
 
 auto lib::json::load(const ghc::filesystem::path &path) -> nlohmann::json
 {
+	// File may still be saving in the background
+	{
+		const auto &state = pending();
+		std::lock_guard<std::mutex> lock(state->mutex);
+
+		const auto item = state->items.find(path.string());
+		if (item != state->items.end())
+		{
+			// Removed, but not yet from disk
+			if (!item->second)
+			{
+				return {};
+			}
+			return *item->second;
+		}
+	}
+
 	std::ifstream file(path);
 	if (!file.is_open() || file.bad())
 	{
@@ -42,16 +61,104 @@ auto lib::json::load(const ghc::filesystem::path &path) -> nlohmann::json
 
 void lib::json::save(const ghc::filesystem::path &path, const nlohmann::json &json)
 {
-	try
+	save(path, nlohmann::json(json));
+}
+
+void lib::json::save(const ghc::filesystem::path &path, nlohmann::json &&json)
+{
+	// Can't move into lambda in C++11
+	std::shared_ptr<const nlohmann::json> item
+		= std::make_shared<nlohmann::json>(std::move(json));
+
+	const auto key = path.string();
+	const auto state = pending();
 	{
-		std::ofstream file(path);
-		file << std::setw(4) << json;
+		std::lock_guard<std::mutex> lock(state->mutex);
+		state->items[key] = item;
 	}
-	catch (const std::exception &e)
+
+	lib::write_queue::get().write(path, [item]() -> std::string
 	{
-		log::warn("Failed to save items to \"{}\": {}",
-			path.string(), e.what());
+		return item->dump();
+	}, [state, key, item]()
+	{
+		// Only remove if not saved again since
+		std::lock_guard<std::mutex> lock(state->mutex);
+		const auto pending_item = state->items.find(key);
+		if (pending_item != state->items.end() && pending_item->second == item)
+		{
+			state->items.erase(pending_item);
+		}
+	});
+}
+
+void lib::json::remove(const ghc::filesystem::path &path)
+{
+	const auto key = path.string();
+	const auto state = pending();
+	{
+		// Kept as empty until removed from disk
+		std::lock_guard<std::mutex> lock(state->mutex);
+		state->items[key] = nullptr;
 	}
+
+	lib::write_queue::get().remove(path, [state, key]()
+	{
+		// Only remove if not saved again since
+		std::lock_guard<std::mutex> lock(state->mutex);
+		const auto pending_item = state->items.find(key);
+		if (pending_item != state->items.end() && !pending_item->second)
+		{
+			state->items.erase(pending_item);
+		}
+	});
+}
+
+void lib::json::flush()
+{
+	lib::write_queue::get().flush();
+}
+
+auto lib::json::list(const ghc::filesystem::path &directory)
+-> std::vector<ghc::filesystem::path>
+{
+	std::set<std::string> files;
+	std::set<std::string> removed;
+
+	// Check pending first, as they're removed after being written
+	{
+		const auto &state = pending();
+		std::lock_guard<std::mutex> lock(state->mutex);
+
+		for (const auto &item: state->items)
+		{
+			if (ghc::filesystem::path(item.first).parent_path() == directory)
+			{
+				(item.second ? files : removed).insert(item.first);
+			}
+		}
+	}
+
+	std::error_code error;
+	if (ghc::filesystem::is_directory(directory, error))
+	{
+		for (const auto &entry: ghc::filesystem::directory_iterator(directory))
+		{
+			if (!lib::write_queue::is_temp(entry.path())
+				&& removed.find(entry.path().string()) == removed.end())
+			{
+				files.insert(entry.path().string());
+			}
+		}
+	}
+
+	return std::vector<ghc::filesystem::path>(files.cbegin(), files.cend());
+}
+
+auto lib::json::pending() -> const std::shared_ptr<pending_items> &
+{
+	static const auto items = std::make_shared<pending_items>();
+	return items;
 }
 
 void lib::json::find_item(const std::string &name, const nlohmann::json &json, std::string &item)
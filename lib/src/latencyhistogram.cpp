@@ -0,0 +1,89 @@
+#include "lib/latencyhistogram.hpp"
+#include "lib/fmt.hpp"
+
+#include <algorithm>
+
+void lib::latency_histogram::add(ms latency)
+{
+	size_t index = 0;
+	while (index < bucket_count - 1 && latency >= upper_bound(index))
+	{
+		index++;
+	}
+
+	buckets.at(index)++;
+	total_count++;
+	total += latency;
+	highest = std::max(highest, latency);
+}
+
+auto lib::latency_histogram::count() const -> size_t
+{
+	return total_count;
+}
+
+auto lib::latency_histogram::mean() const -> ms
+{
+	return total_count > 0
+		? ms(total.count() / static_cast<long long>(total_count))
+		: ms(0);
+}
+
+auto lib::latency_histogram::max() const -> ms
+{
+	return highest;
+}
+
+auto lib::latency_histogram::bucket(size_t index) const -> size_t
+{
+	return buckets.at(index);
+}
+
+auto lib::latency_histogram::upper_bound(size_t index) -> ms
+{
+	switch (index)
+	{
+		case 0:
+			return ms(50);
+
+		case 1:
+			return ms(100);
+
+		case 2:
+			return ms(250);
+
+		case 3:
+			return ms(500);
+
+		case 4:
+			return ms(1000);
+
+		case 5:
+			return ms(2500);
+
+		default:
+			return ms(0);
+	}
+}
+
+void lib::to_json(nlohmann::json &j, const latency_histogram &histogram)
+{
+	auto buckets = nlohmann::json::array();
+	for (size_t i = 0; i < latency_histogram::bucket_count; i++)
+	{
+		const auto bound = latency_histogram::upper_bound(i);
+		buckets.push_back({
+			{"range", bound.count() > 0
+				? lib::fmt::format("< {} ms", bound.count())
+				: lib::fmt::format(">= {} ms", latency_histogram::upper_bound(i - 1).count())},
+			{"count", histogram.bucket(i)},
+		});
+	}
+
+	j = nlohmann::json{
+		{"count", histogram.count()},
+		{"mean_ms", histogram.mean().count()},
+		{"max_ms", histogram.max().count()},
+		{"buckets", buckets},
+	};
+}
@@ -1,36 +1,66 @@
 #include "lib/log.hpp"
 
-std::vector<lib::log_message> lib::log::messages = std::vector<log_message>();
+lib::log_store lib::log::messages(lib::log::capacity);
 
-bool lib::log::log_to_stdout = true;
+// Declared after messages, so pending messages are written to it when destroyed
+lib::log_queue lib::log::queue(&lib::log::write);
 
-void lib::log::message(log_type log_type, const std::string &message)
+std::atomic<bool> lib::log::log_to_stdout(true);
+
+std::atomic<unsigned int> lib::log::enabled_types(~0U);
+
+void lib::log::message(log_type log_type, std::string message)
+{
+	queue.push(log_type, std::move(message));
+}
+
+void lib::log::write(const log_message &message)
 {
-	log_message msg(log_type, message);
-	messages.push_back(msg);
+	messages.add(message);
 
 	if (!log_to_stdout)
 	{
 		return;
 	}
 
+	const auto log_type = message.get_log_type();
 	if (log_type == log_type::information || log_type == log_type::verbose)
 	{
-		std::cout << msg.to_string() << std::endl;
+		std::cout << message.to_string() << std::endl;
+	}
+	else
+	{
+		std::cerr << message.to_string() << std::endl;
+	}
+}
+
+void lib::log::set_enabled(log_type type, bool value)
+{
+	if (value)
+	{
+		enabled_types |= flag(type);
 	}
 	else
 	{
-		std::cerr << msg.to_string() << std::endl;
+		enabled_types &= ~flag(type);
 	}
 }
 
-auto lib::log::get_messages() -> const std::vector<log_message> &
+auto lib::log::get_messages() -> std::vector<log_message>
+{
+	queue.flush();
+	return messages.get_messages();
+}
+
+auto lib::log::get_store() -> log_store &
 {
+	queue.flush();
 	return messages;
 }
 
 void lib::log::clear()
 {
+	queue.flush();
 	messages.clear();
 }
 
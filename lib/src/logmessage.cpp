@@ -65,6 +65,11 @@ auto lib::log_message::get_type() const -> std::string
 	return {};
 }
 
+auto lib::log_message::get_log_type() const -> log_type
+{
+	return logType;
+}
+
 auto lib::log_message::get_message() const -> std::string
 {
 	return message;
@@ -0,0 +1,80 @@
+#include "lib/logqueue.hpp"
+
+lib::log_queue::log_queue(writer write)
+	: write(std::move(write)),
+	thread(&log_queue::run, this)
+{
+}
+
+lib::log_queue::~log_queue()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopped = true;
+	}
+
+	condition.notify_one();
+	thread.join();
+}
+
+void lib::log_queue::push(log_type log_type, std::string message)
+{
+	const auto time = clock::now();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.push_back(entry{time, log_type, std::move(message)});
+	}
+
+	condition.notify_one();
+}
+
+void lib::log_queue::flush()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	written.wait(lock, [this]() -> bool
+	{
+		return pending.empty() && writing.empty();
+	});
+}
+
+auto lib::log_queue::local_time(const clock::time_point &time) -> const date_time &
+{
+	const auto second = clock::to_time_t(time);
+	if (second != last_second || !last_time.is_valid())
+	{
+		last_second = second;
+		last_time = date_time::local(second);
+	}
+	return last_time;
+}
+
+void lib::log_queue::run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while (true)
+	{
+		condition.wait(lock, [this]() -> bool
+		{
+			return stopped || !pending.empty();
+		});
+
+		if (pending.empty() && stopped)
+		{
+			return;
+		}
+
+		writing.swap(pending);
+		lock.unlock();
+
+		for (const auto &item: writing)
+		{
+			write(log_message(local_time(item.time), item.type, item.message));
+		}
+
+		lock.lock();
+		writing.clear();
+		written.notify_all();
+	}
+}
@@ -0,0 +1,221 @@
+#include "lib/logstore.hpp"
+#include "lib/fmt.hpp"
+
+#include <algorithm>
+
+lib::log_store::log_store(size_t capacity)
+{
+	for (auto &ring: rings)
+	{
+		ring.capacity = capacity;
+	}
+}
+
+void lib::log_store::set_capacity(log_type type, size_t capacity)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto &ring = rings.at(index(type));
+
+	// Unwrap, so oldest entry is first
+	std::rotate(ring.entries.begin(), ring.entries.begin() + ring.start, ring.entries.end());
+	ring.start = 0;
+
+	if (ring.entries.size() > capacity)
+	{
+		const auto removed = ring.entries.size() - capacity;
+		for (size_t i = 0; i < removed; i++)
+		{
+			spill(ring.entries.at(i).message);
+		}
+		ring.entries.erase(ring.entries.begin(), ring.entries.begin() + removed);
+	}
+
+	ring.capacity = capacity;
+}
+
+void lib::log_store::set_spill(const ghc::filesystem::path &path, size_t max_size,
+	size_t max_files)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	spill_file.close();
+	spill_path = path;
+	spill_max_size = max_size;
+	spill_max_files = max_files;
+	spill_size = 0;
+
+	if (path.empty())
+	{
+		return;
+	}
+
+	std::error_code error;
+	ghc::filesystem::create_directories(path.parent_path(), error);
+
+	const auto size = ghc::filesystem::file_size(path, error);
+	spill_size = error ? 0 : static_cast<size_t>(size);
+	spill_file.open(path.string(), std::ios::app);
+}
+
+void lib::log_store::add(const log_message &message)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto &ring = rings.at(index(message.get_log_type()));
+	const auto sequence = next_sequence++;
+
+	if (ring.capacity == 0)
+	{
+		spill(message);
+		return;
+	}
+
+	if (ring.entries.size() < ring.capacity)
+	{
+		ring.entries.push_back(entry{sequence, message});
+		return;
+	}
+
+	auto &oldest = ring.entries.at(ring.start);
+	spill(oldest.message);
+	oldest = entry{sequence, message};
+	ring.start = (ring.start + 1) % ring.entries.size();
+}
+
+auto lib::log_store::read(size_t cursor, std::vector<log_message> &messages) const -> size_t
+{
+	std::vector<entry> entries;
+	const auto result = read(cursor, entries);
+
+	messages.reserve(messages.size() + entries.size());
+	for (auto &item: entries)
+	{
+		messages.push_back(std::move(item.message));
+	}
+
+	return result.cursor;
+}
+
+auto lib::log_store::read(size_t cursor, std::vector<entry> &entries) const -> read_result
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	read_result result{};
+	result.cursor = next_sequence;
+
+	std::vector<const entry *> found;
+	for (size_t i = 0; i < rings.size(); i++)
+	{
+		const auto &ring = rings.at(i);
+
+		// Oldest entry is at start once full, empty rings keep nothing
+		result.oldest.at(i) = ring.entries.empty()
+			? next_sequence
+			: ring.entries.at(ring.start).sequence;
+
+		for (const auto &item: ring.entries)
+		{
+			if (item.sequence >= cursor)
+			{
+				found.push_back(&item);
+			}
+		}
+	}
+
+	std::sort(found.begin(), found.end(), [](const entry *lhs, const entry *rhs) -> bool
+	{
+		return lhs->sequence < rhs->sequence;
+	});
+
+	entries.reserve(entries.size() + found.size());
+	for (const auto *item: found)
+	{
+		entries.push_back(*item);
+	}
+
+	return result;
+}
+
+auto lib::log_store::get_messages() const -> std::vector<log_message>
+{
+	std::vector<log_message> messages;
+	read(0, messages);
+	return messages;
+}
+
+auto lib::log_store::size() const -> size_t
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	size_t count = 0;
+	for (const auto &ring: rings)
+	{
+		count += ring.entries.size();
+	}
+	return count;
+}
+
+void lib::log_store::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	for (auto &ring: rings)
+	{
+		ring.entries.clear();
+		ring.start = 0;
+	}
+}
+
+auto lib::log_store::read_result::is_kept(size_t sequence, log_type type) const -> bool
+{
+	return sequence >= oldest.at(index(type));
+}
+
+auto lib::log_store::index(log_type type) -> size_t
+{
+	return std::min(static_cast<size_t>(type), type_count - 1);
+}
+
+void lib::log_store::spill(const log_message &message)
+{
+	if (!spill_file.is_open())
+	{
+		return;
+	}
+
+	const auto line = message.to_string();
+	if (spill_size > 0 && spill_size + line.size() + 1 > spill_max_size)
+	{
+		rotate();
+	}
+
+	// Flushed right away, as the file is mostly useful after a crash
+	spill_file << line << '\n' << std::flush;
+	spill_size += line.size() + 1;
+}
+
+void lib::log_store::rotate()
+{
+	spill_file.close();
+
+	auto rotated = [this](size_t index) -> ghc::filesystem::path
+	{
+		return index == 0
+			? spill_path
+			: ghc::filesystem::path(lib::fmt::format("{}.{}", spill_path.string(), index));
+	};
+
+	std::error_code error;
+	if (spill_max_files > 1)
+	{
+		ghc::filesystem::remove(rotated(spill_max_files - 1), error);
+		for (auto i = spill_max_files - 1; i > 0; i--)
+		{
+			ghc::filesystem::rename(rotated(i - 1), rotated(i), error);
+		}
+	}
+
+	spill_file.open(spill_path.string(), std::ios::trunc);
+	spill_size = 0;
+}
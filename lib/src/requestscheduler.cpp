@@ -0,0 +1,179 @@
+#include "lib/requestscheduler.hpp"
+#include "lib/strings.hpp"
+#include "lib/uri.hpp"
+
+lib::request_scheduler::request_scheduler(size_t max_requests_per_host)
+	: max_requests_per_host(max_requests_per_host > 0 ? max_requests_per_host : 1)
+{
+}
+
+void lib::request_scheduler::schedule(const std::string &url,
+	lib::request_priority priority, const starter &start)
+{
+	const auto url_host = host(url);
+
+	request item{
+		start,
+		priority,
+		clock::now(),
+	};
+
+	if (active(url_host) >= max_requests(url_host))
+	{
+		queued_requests[url_host].at(static_cast<size_t>(priority)).push_back(item);
+		return;
+	}
+
+	this->start(url_host, item);
+}
+
+void lib::request_scheduler::set_multiplexed(const std::string &url)
+{
+	const auto url_host = host(url);
+	if (!multiplexed_hosts.insert(url_host).second)
+	{
+		return;
+	}
+
+	// Send queued requests that now fit
+	while (active(url_host) < max_requests(url_host))
+	{
+		if (!start_next(url_host))
+		{
+			return;
+		}
+	}
+}
+
+auto lib::request_scheduler::priority(const std::string &url) -> lib::request_priority
+{
+	if (lib::strings::contains(url, "/me/player"))
+	{
+		return lib::request_priority::playback;
+	}
+
+	const auto url_host = host(url);
+	if (lib::strings::ends_with(url_host, ".scdn.co")
+		|| lib::strings::contains(url_host, "image"))
+	{
+		return lib::request_priority::image;
+	}
+
+	return lib::request_priority::metadata;
+}
+
+auto lib::request_scheduler::latency(lib::request_priority priority) const
+-> const lib::latency_histogram &
+{
+	return histograms.at(static_cast<size_t>(priority));
+}
+
+auto lib::request_scheduler::active(const std::string &host) const -> size_t
+{
+	const auto iter = active_requests.find(host);
+	return iter == active_requests.end()
+		? 0
+		: iter->second;
+}
+
+auto lib::request_scheduler::queued(const std::string &host) const -> size_t
+{
+	const auto iter = queued_requests.find(host);
+	if (iter == queued_requests.end())
+	{
+		return 0;
+	}
+
+	size_t count = 0;
+	for (const auto &queue: iter->second)
+	{
+		count += queue.size();
+	}
+	return count;
+}
+
+auto lib::request_scheduler::host(const std::string &url) -> std::string
+{
+	try
+	{
+		return lib::uri(url).hostname();
+	}
+	catch (const std::exception &)
+	{
+		// Invalid URLs fail when sent, share a single queue until then
+		return {};
+	}
+}
+
+void lib::request_scheduler::start(const std::string &host, const request &request)
+{
+	active_requests[host]++;
+
+	// Guard against the same request finishing twice
+	auto done = std::make_shared<bool>(false);
+
+	request.start([this, host, request, done]()
+	{
+		if (*done)
+		{
+			return;
+		}
+
+		*done = true;
+		finished(host, request);
+	});
+}
+
+void lib::request_scheduler::finished(const std::string &host, const request &request)
+{
+	histograms.at(static_cast<size_t>(request.priority))
+		.add(std::chrono::duration_cast<lib::latency_histogram::ms>(clock::now()
+			- request.scheduled));
+
+	active_requests[host]--;
+
+	if (active(host) < max_requests(host))
+	{
+		start_next(host);
+	}
+}
+
+auto lib::request_scheduler::start_next(const std::string &host) -> bool
+{
+	auto iter = queued_requests.find(host);
+	if (iter == queued_requests.end())
+	{
+		return false;
+	}
+
+	for (auto &queue: iter->second)
+	{
+		if (queue.empty())
+		{
+			continue;
+		}
+
+		const auto next = queue.front();
+		queue.pop_front();
+		start(host, next);
+		return true;
+	}
+
+	return false;
+}
+
+auto lib::request_scheduler::max_requests(const std::string &host) const -> size_t
+{
+	return multiplexed_hosts.find(host) != multiplexed_hosts.end()
+		? max_multiplexed_requests
+		: max_requests_per_host;
+}
+
+void lib::to_json(nlohmann::json &j, const request_scheduler &scheduler)
+{
+	j = nlohmann::json{
+		{"playback", scheduler.latency(lib::request_priority::playback)},
+		{"metadata", scheduler.latency(lib::request_priority::metadata)},
+		{"image", scheduler.latency(lib::request_priority::image)},
+	};
+}
@@ -0,0 +1,360 @@
+#include "lib/search/trackindex.hpp"
+#include "lib/fmt.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+auto lib::track_index::set_tracks(const std::string &source_id,
+	const std::vector<lib::spt::track> &tracks) -> bool
+{
+	const auto tracks_hash = hash(tracks);
+
+	const auto source_hash = source_hashes.find(source_id);
+	if (source_hash != source_hashes.end() && source_hash->second == tracks_hash)
+	{
+		return false;
+	}
+
+	// Add new tracks before removing old ones, to keep unchanged tracks indexed
+	std::vector<doc_id> ids;
+	ids.reserve(tracks.size());
+	for (const auto &track: tracks)
+	{
+		ids.push_back(add_document(track));
+	}
+
+	for (const auto id: sources[source_id])
+	{
+		release_document(id);
+	}
+
+	sources[source_id] = ids;
+	source_hashes[source_id] = tracks_hash;
+	return true;
+}
+
+void lib::track_index::remove_source(const std::string &source_id)
+{
+	const auto source = sources.find(source_id);
+	if (source == sources.end())
+	{
+		return;
+	}
+
+	for (const auto id: source->second)
+	{
+		release_document(id);
+	}
+
+	sources.erase(source);
+	source_hashes.erase(source_id);
+}
+
+auto lib::track_index::has_source(const std::string &source_id) const -> bool
+{
+	return sources.find(source_id) != sources.end();
+}
+
+auto lib::track_index::search(const std::string &query) const -> std::vector<lib::spt::track>
+{
+	const auto words = tokenize(query);
+	if (words.empty())
+	{
+		return {};
+	}
+
+	auto matches = match(words.front());
+	for (auto word = words.cbegin() + 1; word != words.cend() && !matches.empty(); word++)
+	{
+		const auto word_matches = match(*word);
+
+		std::vector<doc_id> intersection;
+		std::set_intersection(matches.cbegin(), matches.cend(),
+			word_matches.cbegin(), word_matches.cend(),
+			std::back_inserter(intersection));
+
+		matches = std::move(intersection);
+	}
+
+	std::sort(matches.begin(), matches.end(), [this](doc_id lhs, doc_id rhs) -> bool
+	{
+		return documents.at(lhs).sequence < documents.at(rhs).sequence;
+	});
+
+	std::vector<lib::spt::track> results;
+	results.reserve(matches.size());
+
+	for (const auto id: matches)
+	{
+		results.push_back(documents.at(id).track);
+	}
+
+	return results;
+}
+
+auto lib::track_index::size() const -> size_t
+{
+	return document_ids.size();
+}
+
+auto lib::track_index::tokenize(const std::string &text) -> std::vector<std::string>
+{
+	std::vector<std::string> words;
+	std::string word;
+
+	for (const auto c: text)
+	{
+		const auto byte = static_cast<unsigned char>(c);
+
+		// Non-ASCII characters are always considered part of a word
+		if (byte >= 0x80 || std::isalnum(byte) != 0)
+		{
+			word += static_cast<char>(std::tolower(byte));
+			continue;
+		}
+
+		if (!word.empty())
+		{
+			words.push_back(word);
+			word.clear();
+		}
+	}
+
+	if (!word.empty())
+	{
+		words.push_back(word);
+	}
+
+	return words;
+}
+
+//region private
+
+auto lib::track_index::add_document(const lib::spt::track &track) -> doc_id
+{
+	const auto track_key = key(track);
+
+	const auto existing = document_ids.find(track_key);
+	if (existing != document_ids.end())
+	{
+		auto &doc = documents.at(existing->second);
+		doc.references++;
+
+		if (track_terms(doc.track) != track_terms(track))
+		{
+			remove_postings(existing->second);
+			doc.track = track;
+			add_postings(existing->second);
+		}
+
+		return existing->second;
+	}
+
+	doc_id id;
+	if (free_documents.empty())
+	{
+		id = static_cast<doc_id>(documents.size());
+		documents.push_back(document{track, 1, next_sequence++});
+	}
+	else
+	{
+		id = free_documents.back();
+		free_documents.pop_back();
+		documents.at(id) = document{track, 1, next_sequence++};
+	}
+
+	document_ids[track_key] = id;
+	add_postings(id);
+	return id;
+}
+
+void lib::track_index::release_document(doc_id id)
+{
+	auto &doc = documents.at(id);
+	if (--doc.references > 0)
+	{
+		return;
+	}
+
+	remove_postings(id);
+	document_ids.erase(key(doc.track));
+	doc.track = lib::spt::track();
+	free_documents.push_back(id);
+}
+
+void lib::track_index::add_postings(doc_id id)
+{
+	for (const auto &term: track_terms(documents.at(id).track))
+	{
+		auto &postings = terms[term];
+		if (postings.empty())
+		{
+			for (const auto &trigram: word_trigrams(term))
+			{
+				trigrams[trigram].insert(term);
+			}
+		}
+
+		const auto position = std::lower_bound(postings.begin(), postings.end(), id);
+		if (position == postings.end() || *position != id)
+		{
+			postings.insert(position, id);
+		}
+	}
+}
+
+void lib::track_index::remove_postings(doc_id id)
+{
+	for (const auto &term: track_terms(documents.at(id).track))
+	{
+		const auto item = terms.find(term);
+		if (item == terms.end())
+		{
+			continue;
+		}
+
+		auto &postings = item->second;
+		const auto position = std::lower_bound(postings.begin(), postings.end(), id);
+		if (position != postings.end() && *position == id)
+		{
+			postings.erase(position);
+		}
+
+		if (!postings.empty())
+		{
+			continue;
+		}
+
+		terms.erase(item);
+		for (const auto &trigram: word_trigrams(term))
+		{
+			auto words = trigrams.find(trigram);
+			if (words == trigrams.end())
+			{
+				continue;
+			}
+
+			words->second.erase(term);
+			if (words->second.empty())
+			{
+				trigrams.erase(words);
+			}
+		}
+	}
+}
+
+auto lib::track_index::match(const std::string &word) const -> std::vector<doc_id>
+{
+	std::vector<doc_id> results;
+
+	// Words starting with query word
+	for (auto term = terms.lower_bound(word); term != terms.end()
+		&& term->first.compare(0, word.size(), word) == 0; term++)
+	{
+		results.insert(results.end(), term->second.cbegin(), term->second.cend());
+	}
+
+	// Words containing query word, using the least common sequence of characters
+	const std::set<std::string> *candidates = nullptr;
+	for (const auto &trigram: word_trigrams(word))
+	{
+		const auto words = trigrams.find(trigram);
+		if (words == trigrams.end())
+		{
+			candidates = nullptr;
+			break;
+		}
+
+		if (candidates == nullptr || words->second.size() < candidates->size())
+		{
+			candidates = &words->second;
+		}
+	}
+
+	if (candidates != nullptr)
+	{
+		for (const auto &candidate: *candidates)
+		{
+			if (candidate.compare(0, word.size(), word) != 0
+				&& candidate.find(word) != std::string::npos)
+			{
+				const auto &postings = terms.at(candidate);
+				results.insert(results.end(), postings.cbegin(), postings.cend());
+			}
+		}
+	}
+
+	std::sort(results.begin(), results.end());
+	results.erase(std::unique(results.begin(), results.end()), results.end());
+	return results;
+}
+
+auto lib::track_index::key(const lib::spt::track &track) -> std::string
+{
+	// Local tracks don't have an ID
+	return track.id.empty()
+		? lib::fmt::format("{}\n{}", track.name, track.album.name)
+		: track.id;
+}
+
+auto lib::track_index::hash(const std::vector<lib::spt::track> &tracks) -> size_t
+{
+	std::hash<std::string> hasher;
+	size_t value = tracks.size();
+
+	auto combine = [&value, &hasher](const std::string &str)
+	{
+		constexpr size_t golden_ratio = 0x9e3779b9;
+		value ^= hasher(str) + golden_ratio + (value << 6U) + (value >> 2U);
+	};
+
+	for (const auto &track: tracks)
+	{
+		combine(track.id);
+		combine(track.name);
+		combine(track.album.name);
+		for (const auto &artist: track.artists)
+		{
+			combine(artist.name);
+		}
+	}
+
+	return value;
+}
+
+auto lib::track_index::track_terms(const lib::spt::track &track) -> std::set<std::string>
+{
+	std::set<std::string> results;
+
+	auto add = [&results](const std::string &text)
+	{
+		for (auto &word: tokenize(text))
+		{
+			results.insert(std::move(word));
+		}
+	};
+
+	add(track.name);
+	add(track.album.name);
+	for (const auto &artist: track.artists)
+	{
+		add(artist.name);
+	}
+
+	return results;
+}
+
+auto lib::track_index::word_trigrams(const std::string &word) -> std::vector<std::string>
+{
+	constexpr size_t length = 3;
+	std::vector<std::string> results;
+
+	for (size_t i = 0; i + length <= word.size(); i++)
+	{
+		results.push_back(word.substr(i, length));
+	}
+
+	return results;
+}
+
+//endregion
@@ -6,6 +6,22 @@ lib::settings::settings(const paths &paths)
 	load();
 }
 
+lib::settings::~settings()
+{
+	if (thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopped = true;
+		}
+
+		condition.notify_one();
+		thread.join();
+	}
+
+	flush();
+}
+
 auto lib::settings::file_name() const -> std::string
 {
 	return path.config_file().string();
@@ -82,7 +98,81 @@ auto lib::settings::to_json() const -> nlohmann::json
 
 void lib::settings::save()
 {
-	std::lock_guard<std::mutex> lock(mutex);
+	// Settings are only modified from the calling thread, so copy them here
+	auto json = to_json();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending = std::move(json);
+		saves++;
+
+		if (!thread.joinable())
+		{
+			thread = std::thread(&settings::run, this);
+		}
+	}
+
+	condition.notify_one();
+}
+
+void lib::settings::flush()
+{
+	write();
+}
+
+void lib::settings::run()
+{
+	constexpr std::chrono::milliseconds save_delay(1000);
+
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while (true)
+	{
+		condition.wait(lock, [this]() -> bool
+		{
+			return stopped || !pending.is_null();
+		});
+
+		if (stopped)
+		{
+			return;
+		}
+
+		// Wait until no more changes are saved for a while
+		auto count = saves;
+		while (condition.wait_for(lock, save_delay, [this, count]() -> bool
+		{
+			return stopped || saves != count;
+		}))
+		{
+			if (stopped)
+			{
+				// Written when destroyed
+				return;
+			}
+			count = saves;
+		}
+
+		lock.unlock();
+		write();
+		lock.lock();
+	}
+}
+
+void lib::settings::write()
+{
+	// Held while taking pending settings, so older settings are never written last
+	std::lock_guard<std::mutex> write_lock(write_mutex);
+
+	nlohmann::json json;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (pending.is_null())
+		{
+			return;
+		}
+		json.swap(pending);
+	}
 
 	auto file_dir = file_path();
 	if (!ghc::filesystem::exists(file_dir))
@@ -90,9 +180,7 @@ void lib::settings::save()
 		ghc::filesystem::create_directories(file_dir);
 	}
 
-	std::ofstream file(file_name());
-	file << std::setw(4) << to_json();
-	file.close();
+	lib::write_queue::write_atomic(file_name(), json.dump(4));
 }
 
 void lib::settings::remove_client()
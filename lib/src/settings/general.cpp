@@ -3,6 +3,8 @@
 void lib::setting::to_json(nlohmann::json &j, const general &g)
 {
 	j = nlohmann::json{
+		{"album_cache_size", g.album_cache_size},
+		{"cache_type", g.cache_type},
 		{"close_to_tray", g.close_to_tray},
 		{"custom_playlist_order", g.custom_playlist_order},
 		{"fallback_icons", g.fallback_icons},
@@ -37,6 +39,8 @@ void lib::setting::from_json(const nlohmann::json &j, general &g)
 		return;
 	}
 
+	lib::json::get(j, "album_cache_size", g.album_cache_size);
+	lib::json::get(j, "cache_type", g.cache_type);
 	lib::json::get(j, "close_to_tray", g.close_to_tray);
 	lib::json::get(j, "custom_playlist_order", g.custom_playlist_order);
 	lib::json::get(j, "fallback_icons", g.fallback_icons);
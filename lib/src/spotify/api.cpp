@@ -3,88 +3,42 @@
 
 lib::spt::api::api(lib::settings &settings, const lib::http_client &http_client)
 	: settings(settings),
-	http(http_client)
+	http(http_client),
+	tokens(settings, http_client),
+	responses(max_response_cache_size)
 {
 }
 
 void lib::spt::api::refresh(bool force)
 {
-	constexpr long s_in_hour = 60 * 60;
-
-	if (!force
-		&& lib::date_time::seconds_since_epoch() - settings.account.last_refresh < s_in_hour)
+	if (!force && tokens.expires_in() > 0)
 	{
-		lib::log::debug("Last refresh was less than an hour ago, not refreshing access token");
-		last_auth = settings.account.last_refresh;
+		lib::log::debug("Access token still valid, not refreshing");
 		return;
 	}
 
-	// Make sure we have a refresh token
-	auto refresh_token = settings.account.refresh_token;
-	if (refresh_token.empty())
-	{
-		throw lib::spt::error("No refresh token", "token");
-	}
-
-	// Create form
-	auto post_data = lib::fmt::format("grant_type=refresh_token&refresh_token={}",
-		refresh_token);
-
-	// Create request
-	auto auth_header = lib::fmt::format("Basic {}",
-		lib::base64::encode(lib::fmt::format("{}:{}",
-			settings.account.client_id, settings.account.client_secret)));
-
-	// Send request
-	auto reply = request_refresh(post_data, auth_header);
-	if (reply.empty())
-	{
-		throw lib::spt::error("No response", "token");
-	}
-
-	// Parse as JSON
-	const auto json = nlohmann::json::parse(reply);
-
-	// Check if error
-	if (json.contains("error_description") || !json.contains("access_token"))
-	{
-		auto error = json.at("error_description").get<std::string>();
-		throw lib::spt::error(error.empty()
-			? "No access token" : error, "token");
-	}
+	tokens.refresh();
+}
 
-	// Save as access token
-	last_auth = lib::date_time::seconds_since_epoch();
-	settings.account.last_refresh = last_auth;
-	settings.account.access_token = json.at("access_token").get<std::string>();
-	settings.save();
+void lib::spt::api::refresh(lib::callback<std::string> &callback)
+{
+	tokens.refresh(callback);
 }
 
-auto lib::spt::api::auth_headers() -> lib::headers
+auto lib::spt::api::get_response_stats() const -> const lib::http_cache::stats &
 {
-	constexpr int secsInHour = 3600;
+	return responses.get_stats();
+}
 
-	// See when last refresh was
-	auto last_refresh = lib::date_time::seconds_since_epoch() - last_auth;
-	if (last_refresh >= secsInHour)
+void lib::spt::api::auth_headers(const std::string &content_type,
+	lib::callback<lib::headers> &callback)
+{
+	tokens.headers([content_type, callback](const lib::headers &headers)
 	{
-		lib::log::debug("Access token probably expired, refreshing");
-		try
-		{
-			refresh();
-		}
-		catch (const std::exception &e)
-		{
-			lib::log::error("Refresh failed: {}", e.what());
-		}
-	}
-
-	return {
-		{
-			"Authorization",
-			lib::fmt::format("Bearer {}", settings.account.access_token),
-		},
-	};
+		auto request_headers = headers;
+		request_headers["Content-Type"] = content_type;
+		callback(request_headers);
+	});
 }
 
 auto lib::spt::api::parse_json(const std::string &url, const std::string &data) -> nlohmann::json
@@ -107,15 +61,6 @@ auto lib::spt::api::parse_json(const std::string &url, const std::string &data)
 	throw lib::spt::error(err, url);
 }
 
-auto lib::spt::api::request_refresh(const std::string &post_data,
-	const std::string &authorization) -> std::string
-{
-	return http.post("https://accounts.spotify.com/api/token", {
-		{"Content-Type", "application/x-www-form-urlencoded"},
-		{"Authorization", authorization},
-	}, post_data);
-}
-
 auto lib::spt::api::error_message(const std::string &url, const std::string &data) -> std::string
 {
 	nlohmann::json json;
@@ -191,6 +136,11 @@ void lib::spt::api::set_current_device(const std::string &id)
 	settings.save();
 }
 
+void lib::spt::api::set_max_page_requests(size_t value)
+{
+	max_page_requests = value;
+}
+
 auto lib::spt::api::get_current_device() const -> const std::string &
 {
 	return settings.general.last_device;
@@ -226,19 +176,71 @@ auto lib::spt::api::get_device_url(const std::string &url,
 
 void lib::spt::api::get(const std::string &url, lib::callback<nlohmann::json> &callback)
 {
-	http.get(to_full_url(url), auth_headers(),
-		[url, callback](const std::string &response)
+	tokens.headers([this, url, callback](const lib::headers &headers)
+	{
+		const auto full_url = to_full_url(url);
+
+		nlohmann::json cached;
+		if (responses.get_fresh(full_url, cached))
+		{
+			callback(cached);
+			return;
+		}
+
+		get_response(url, headers, true, callback);
+	});
+}
+
+void lib::spt::api::get_response(const std::string &url, const lib::headers &headers,
+	bool conditional, lib::callback<nlohmann::json> &callback)
+{
+	constexpr int status_not_modified = 304;
+
+	const auto full_url = to_full_url(url);
+
+	auto request_headers = headers;
+	if (conditional)
+	{
+		responses.add_headers(full_url, request_headers);
+	}
+
+	http.get_response(full_url, request_headers,
+		[this, url, full_url, headers, conditional, callback]
+			(const lib::http_response &response)
 		{
+			nlohmann::json json;
+			if (responses.get_not_modified(full_url, response, json))
+			{
+				callback(json);
+				return;
+			}
+
+			// Cached response was removed while waiting for response
+			if (conditional && response.status == status_not_modified)
+			{
+				responses.remove(full_url);
+				get_response(url, headers, false, callback);
+				return;
+			}
+
 			try
 			{
-				callback(response.empty()
-					? nlohmann::json()
-					: nlohmann::json::parse(response));
+				if (!response.body.empty())
+				{
+					json = nlohmann::json::parse(response.body);
+					responses.set(full_url, response, json);
+				}
 			}
 			catch (const nlohmann::json::parse_error &e)
 			{
 				lib::log::error("{} failed to parse: {}", url, e.what());
-				lib::log::debug("JSON: {}", response);
+				lib::log::debug("JSON: {}", response.body);
+				return;
+			}
+
+			try
+			{
+				callback(json);
 			}
 			catch (const std::exception &e)
 			{
@@ -247,8 +249,7 @@ void lib::spt::api::get(const std::string &url, lib::callback<nlohmann::json> &c
 		});
 }
 
-void lib::spt::api::get_items(const std::string &url, const std::string &key,
-	lib::callback<nlohmann::json> &callback)
+void lib::spt::api::get_page(const std::string &url, lib::callback<nlohmann::json> &callback)
 {
 	constexpr size_t api_prefix_length = 27;
 
@@ -256,26 +257,17 @@ void lib::spt::api::get_items(const std::string &url, const std::string &key,
 		? url.substr(api_prefix_length)
 		: url;
 
-	get(api_url, [this, key, callback](const nlohmann::json &json)
-	{
-		if (!key.empty() && !json.contains(key))
-		{
-			lib::log::error(R"(no such key "{}" in "{}")", key, json.dump());
-		}
+	get(api_url, callback);
+}
 
-		const auto &content = key.empty() ? json : json.at(key);
-		const auto &items = content.at("items");
-		if (content.contains("next") && content.at("next").is_string())
+void lib::spt::api::get_items(const std::string &url, const std::string &key,
+	lib::callback<nlohmann::json> &callback)
+{
+	lib::spt::paginator::load(url, key, max_page_requests,
+		[this](const std::string &page_url, lib::callback<nlohmann::json> &page_callback)
 		{
-			const auto &next = content.at("next").get<std::string>();
-			get_items(next, key, [items, callback](const nlohmann::json &next)
-			{
-				callback(lib::json::combine(items, next));
-			});
-			return;
-		}
-		callback(items);
-	});
+			get_page(page_url, page_callback);
+		}, callback);
 }
 
 void lib::spt::api::get_items(const std::string &url, lib::callback<nlohmann::json> &callback)
@@ -283,6 +275,15 @@ void lib::spt::api::get_items(const std::string &url, lib::callback<nlohmann::js
 	get_items(url, std::string(), callback);
 }
 
+void lib::spt::api::get_pages(const std::string &url, lib::paged<nlohmann::json> &callback)
+{
+	lib::spt::paginator::stream(url, std::string(), max_page_requests,
+		[this](const std::string &page_url, lib::callback<nlohmann::json> &page_callback)
+		{
+			get_page(page_url, page_callback);
+		}, callback);
+}
+
 //endregion
 
 //region PUT
@@ -290,67 +291,68 @@ void lib::spt::api::get_items(const std::string &url, lib::callback<nlohmann::js
 void lib::spt::api::put(const std::string &url, const nlohmann::json &body,
 	lib::callback<std::string> &callback)
 {
-	auto header = auth_headers();
-	header["Content-Type"] = "application/json";
-
 	auto data = body.is_null()
 		? std::string()
 		: body.dump();
 
-	http.put(to_full_url(url), data, header,
-		[this, url, body, callback](const std::string &response)
-		{
-			auto error = error_message(url, response);
-
-			const auto noDevice = lib::strings::contains(error, "No active device found");
-			const auto invalidDevice = lib::strings::contains(error, "Device not found");
-
-			if (noDevice || invalidDevice)
+	auth_headers("application/json", [this, url, body, data, callback](const lib::headers &headers)
+	{
+		http.put(to_full_url(url), data, headers,
+			[this, url, body, callback](const std::string &response)
 			{
-				if (invalidDevice)
-				{
-					set_current_device(std::string());
-				}
+				responses.expire();
+				auto error = error_message(url, response);
+
+				const auto noDevice = lib::strings::contains(error, "No active device found");
+				const auto invalidDevice = lib::strings::contains(error, "Device not found");
 
-				devices([this, url, body, error, callback]
-					(const std::vector<lib::spt::device> &devices)
+				if (noDevice || invalidDevice)
 				{
-					if (devices.empty())
+					if (invalidDevice)
 					{
-						if (callback)
-						{
-							callback(error);
-						}
+						set_current_device(std::string());
 					}
-					else
+
+					devices([this, url, body, error, callback]
+						(const std::vector<lib::spt::device> &devices)
 					{
-						this->select_device(devices, [this, url, body, callback, error]
-							(const lib::spt::device &device)
+						if (devices.empty())
 						{
-							if (device.id.empty())
+							if (callback)
 							{
 								callback(error);
-								return;
 							}
-
-							this->set_device(device, [this, url, body, callback, device]
-								(const std::string &status)
+						}
+						else
+						{
+							this->select_device(devices, [this, url, body, callback, error]
+								(const lib::spt::device &device)
 							{
-								if (status.empty())
+								if (device.id.empty())
 								{
-									set_current_device(device.id);
-									this->put(get_device_url(url, device), body, callback);
+									callback(error);
+									return;
 								}
+
+								this->set_device(device, [this, url, body, callback, device]
+									(const std::string &status)
+								{
+									if (status.empty())
+									{
+										set_current_device(device.id);
+										this->put(get_device_url(url, device), body, callback);
+									}
+								});
 							});
-						});
-					}
-				});
-			}
-			else if (callback)
-			{
-				callback(error);
-			}
-		});
+						}
+					});
+				}
+				else if (callback)
+				{
+					callback(error);
+				}
+			});
+	});
 }
 
 void lib::spt::api::put(const std::string &url, lib::callback<std::string> &callback)
@@ -364,46 +366,49 @@ void lib::spt::api::put(const std::string &url, lib::callback<std::string> &call
 
 void lib::spt::api::post(const std::string &url, lib::callback<std::string> &callback)
 {
-	auto headers = auth_headers();
-	headers["Content-Type"] = "application/x-www-form-urlencoded";
-
-	http.post(to_full_url(url), headers, [url, callback](const std::string &response)
+	auth_headers("application/x-www-form-urlencoded", [this, url, callback]
+		(const lib::headers &headers)
 	{
-		callback(error_message(url, response));
+		http.post(to_full_url(url), headers, [this, url, callback](const std::string &response)
+		{
+			responses.expire();
+			callback(error_message(url, response));
+		});
 	});
 }
 
 void lib::spt::api::post(const std::string &url, const nlohmann::json &json,
 	lib::callback<nlohmann::json> &callback)
 {
-	auto headers = auth_headers();
-	headers["Content-Type"] = "application/json";
-
 	auto data = json.is_null()
 		? std::string()
 		: json.dump();
 
-	http.post(to_full_url(url), data, headers,
-		[url, callback](const std::string &response)
-		{
-			try
-			{
-				callback(response.empty()
-					? nlohmann::json()
-					: nlohmann::json::parse(response));
-			}
-			catch (const nlohmann::json::parse_error &e)
-			{
-				lib::log::error("{} failed to parse: {}", url, e.what());
-				lib::log::debug("JSON: {}", response);
-			}
-			catch (const std::exception &e)
+	auth_headers("application/json", [this, url, data, callback](const lib::headers &headers)
+	{
+		http.post(to_full_url(url), data, headers,
+			[this, url, callback](const std::string &response)
 			{
-				lib::log::error("{} failed: {}", url, e.what());
-			}
-		});
-}
+				responses.expire();
 
+				try
+				{
+					callback(response.empty()
+						? nlohmann::json()
+						: nlohmann::json::parse(response));
+				}
+				catch (const nlohmann::json::parse_error &e)
+				{
+					lib::log::error("{} failed to parse: {}", url, e.what());
+					lib::log::debug("JSON: {}", response);
+				}
+				catch (const std::exception &e)
+				{
+					lib::log::error("{} failed: {}", url, e.what());
+				}
+			});
+	});
+}
 
 //endregion
 
@@ -412,18 +417,19 @@ void lib::spt::api::post(const std::string &url, const nlohmann::json &json,
 void lib::spt::api::del(const std::string &url, const nlohmann::json &json,
 	lib::callback<std::string> &callback)
 {
-	auto headers = auth_headers();
-	headers["Content-Type"] = "application/json";
-
 	auto data = json.is_null()
 		? std::string()
 		: json.dump();
 
-	http.del(to_full_url(url), data, headers,
-		[url, callback](const std::string &response)
-		{
-			callback(error_message(url, response));
-		});
+	auth_headers("application/json", [this, url, data, callback](const lib::headers &headers)
+	{
+		http.del(to_full_url(url), data, headers,
+			[this, url, callback](const std::string &response)
+			{
+				responses.expire();
+				callback(error_message(url, response));
+			});
+	});
 }
 
 void lib::spt::api::del(const std::string &url, lib::callback<std::string> &callback)
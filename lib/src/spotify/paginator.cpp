@@ -0,0 +1,220 @@
+#include "lib/spotify/paginator.hpp"
+
+lib::spt::paginator::paginator(const std::string &key, size_t max_requests, fetcher fetch)
+	: key(key),
+	max_requests(max_requests > 0 ? max_requests : 1),
+	fetch(std::move(fetch))
+{
+}
+
+void lib::spt::paginator::load(const std::string &url, const std::string &key,
+	size_t max_requests, const fetcher &fetch, lib::callback<nlohmann::json> &callback)
+{
+	std::shared_ptr<paginator> instance(new paginator(key, max_requests, fetch));
+	instance->callback = callback;
+	start(instance, url);
+}
+
+void lib::spt::paginator::stream(const std::string &url, const std::string &key,
+	size_t max_requests, const fetcher &fetch, lib::paged<nlohmann::json> &callback)
+{
+	std::shared_ptr<paginator> instance(new paginator(key, max_requests, fetch));
+	instance->page_callback = callback;
+	start(instance, url);
+}
+
+void lib::spt::paginator::start(const std::shared_ptr<paginator> &instance,
+	const std::string &url)
+{
+	instance->fetch(url, [instance](const nlohmann::json &json)
+	{
+		instance->first_loaded(json);
+	});
+}
+
+auto lib::spt::paginator::page_url(const std::string &url, size_t offset) -> std::string
+{
+	if (!lib::strings::contains(url, "://"))
+	{
+		return {};
+	}
+
+	lib::uri uri(url);
+	auto params = uri.get_search_params();
+
+	auto param = params.find("offset");
+	if (param == params.end())
+	{
+		return {};
+	}
+
+	param->second = std::to_string(offset);
+	uri.set_search_params(params);
+	return uri.get_url();
+}
+
+auto lib::spt::paginator::content(const nlohmann::json &json) const -> const nlohmann::json &
+{
+	if (!key.empty() && !json.contains(key))
+	{
+		lib::log::error(R"(no such key "{}" in "{}")", key, json.dump());
+	}
+
+	return key.empty() ? json : json.at(key);
+}
+
+void lib::spt::paginator::set_page(size_t index, const nlohmann::json &json)
+{
+	const auto &items = content(json).at("items");
+	pages[index] = items.is_array()
+		? items
+		: nlohmann::json::array();
+}
+
+void lib::spt::paginator::first_loaded(const nlohmann::json &json)
+{
+	const auto &page = content(json);
+	pages.resize(1);
+	set_page(0, json);
+
+	if (!page.contains("next") || !page.at("next").is_string())
+	{
+		complete = true;
+		stream_pages();
+		finish();
+		return;
+	}
+
+	base_url = page.at("next").get<std::string>();
+	if (page_url(base_url, 0).empty()
+		|| !page.contains("total") || !page.at("total").is_number()
+		|| !page.contains("limit") || !page.at("limit").is_number())
+	{
+		// Cursor based, next page is only known after loading current one
+		stream_pages();
+		load_next(json);
+		return;
+	}
+
+	lib::json::get(page, "offset", first_offset);
+	page.at("limit").get_to(limit);
+
+	const auto total = page.at("total").get<size_t>();
+	if (limit > 0 && total > first_offset + limit)
+	{
+		pages.resize((total - first_offset + limit - 1) / limit);
+	}
+
+	complete = true;
+	next_page = 1;
+	loaded_pages = 1;
+	stream_pages();
+
+	if (pages.size() == 1)
+	{
+		finish();
+		return;
+	}
+
+	request_pages();
+}
+
+void lib::spt::paginator::request_pages()
+{
+	auto self = shared_from_this();
+
+	while (next_page < pages.size() && next_page - loaded_pages < max_requests)
+	{
+		const auto index = next_page++;
+		fetch(page_url(base_url, first_offset + index * limit),
+			[self, index](const nlohmann::json &json)
+			{
+				self->page_loaded(index, json);
+			});
+	}
+}
+
+void lib::spt::paginator::page_loaded(size_t index, const nlohmann::json &json)
+{
+	set_page(index, json);
+	stream_pages();
+
+	if (++loaded_pages >= pages.size())
+	{
+		finish();
+		return;
+	}
+
+	request_pages();
+}
+
+void lib::spt::paginator::load_next(const nlohmann::json &json)
+{
+	const auto &page = content(json);
+	if (!page.contains("next") || !page.at("next").is_string())
+	{
+		finish();
+		return;
+	}
+
+	auto self = shared_from_this();
+	fetch(page.at("next").get<std::string>(), [self](const nlohmann::json &json)
+	{
+		const auto &next = self->content(json);
+		self->complete = !next.contains("next") || !next.at("next").is_string();
+
+		self->pages.emplace_back();
+		self->set_page(self->pages.size() - 1, json);
+		self->stream_pages();
+		self->load_next(json);
+	});
+}
+
+void lib::spt::paginator::stream_pages()
+{
+	if (!page_callback)
+	{
+		return;
+	}
+
+	while (streamed_pages < pages.size() && !pages[streamed_pages].is_null())
+	{
+		const auto index = streamed_pages++;
+		const auto is_last = complete && streamed_pages >= pages.size();
+
+		page_callback(pages[index], is_last);
+
+		// Page is no longer needed after being streamed
+		pages[index] = nlohmann::json::array();
+	}
+}
+
+void lib::spt::paginator::finish()
+{
+	if (!callback)
+	{
+		pages.clear();
+		return;
+	}
+
+	size_t count = 0;
+	for (const auto &page: pages)
+	{
+		count += page.size();
+	}
+
+	auto items = nlohmann::json::array();
+	auto &array = items.get_ref<nlohmann::json::array_t &>();
+	array.reserve(count);
+
+	for (auto &page: pages)
+	{
+		for (auto &item: page)
+		{
+			array.push_back(std::move(item));
+		}
+	}
+
+	pages.clear();
+	callback(items);
+}
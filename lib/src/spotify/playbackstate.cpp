@@ -0,0 +1,93 @@
+#include "lib/spotify/playbackstate.hpp"
+
+#include <algorithm>
+
+auto lib::spt::playback_state::changes::any() const -> bool
+{
+	return track || playing || progress || volume || shuffle || repeat;
+}
+
+auto lib::spt::playback_state::update(const lib::spt::playback &playback,
+	clock::time_point time) -> changes
+{
+	changes result;
+	result.track = !has_playback || playback.item.id != current.item.id;
+	result.playing = !has_playback || playback.is_playing != current.is_playing;
+	result.progress = !has_playback || result.track
+		|| playback.progress_ms != current.progress_ms
+		|| playback.item.duration != current.item.duration;
+	result.volume = !has_playback || playback.volume() != current.volume();
+	result.shuffle = !has_playback || playback.shuffle != current.shuffle;
+	result.repeat = !has_playback || playback.repeat != current.repeat;
+
+	current = playback;
+	updated = time;
+	has_playback = true;
+	return result;
+}
+
+auto lib::spt::playback_state::update(const lib::spt::playback &playback) -> changes
+{
+	return update(playback, clock::now());
+}
+
+auto lib::spt::playback_state::get() const -> const lib::spt::playback &
+{
+	return current;
+}
+
+auto lib::spt::playback_state::progress_ms(clock::time_point now) const -> int
+{
+	if (!current.is_playing || now <= updated)
+	{
+		return current.progress_ms;
+	}
+
+	const auto elapsed = std::chrono::duration_cast<ms>(now - updated).count();
+	const auto progress = current.progress_ms + static_cast<int>(elapsed);
+
+	return current.item.duration > 0
+		? std::min(progress, current.item.duration)
+		: progress;
+}
+
+auto lib::spt::playback_state::progress_ms() const -> int
+{
+	return progress_ms(clock::now());
+}
+
+auto lib::spt::playback_state::poll_interval(ms interval, bool is_visible) const -> ms
+{
+	return poll_interval(interval, is_visible, clock::now());
+}
+
+auto lib::spt::playback_state::poll_interval(ms interval, bool is_visible,
+	clock::time_point now) const -> ms
+{
+	// Polling when track ends is as fast as it gets
+	constexpr ms min_interval(1000);
+	constexpr ms max_interval(60000);
+	constexpr ms track_end_margin(500);
+	constexpr int slow_factor = 4;
+
+	const auto is_playing = current.is_playing && current.item.duration > 0;
+
+	auto result = std::max(interval, min_interval);
+	if (!is_playing)
+	{
+		result *= slow_factor;
+	}
+	if (!is_visible)
+	{
+		result *= slow_factor;
+	}
+	result = std::min(result, max_interval);
+
+	if (is_playing)
+	{
+		const ms remaining(current.item.duration - progress_ms(now));
+		result = std::max(std::min(result, remaining + track_end_margin), min_interval);
+	}
+
+	return result;
+}
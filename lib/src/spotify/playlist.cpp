@@ -102,9 +102,10 @@ auto lib::spt::playlist::is_null() const -> bool
 	return id.empty();
 }
 
-auto lib::spt::playlist::is_up_to_date(const std::string &playlist_snapshot,
-	const lib::spt::user &current_user) const -> bool
+auto lib::spt::playlist::is_up_to_date(const lib::spt::playlist &cached) const -> bool
 {
-	return owner_id != current_user.id
-		&& snapshot == playlist_snapshot;
+	return !cached.is_null()
+		&& !snapshot.empty()
+		&& snapshot == cached.snapshot
+		&& (tracks_total < 0 || static_cast<size_t>(tracks_total) == cached.tracks.size());
 }
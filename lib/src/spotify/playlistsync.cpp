@@ -0,0 +1,191 @@
+#include "lib/spotify/playlistsync.hpp"
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+void lib::spt::playlist_sync::sync(lib::spt::api &spotify, lib::cache &cache,
+	const lib::spt::playlist &playlist, const synced &callback)
+{
+	constexpr size_t page_size = 100;
+
+	const auto cached = cache.get_playlist(playlist.id);
+	if (playlist.is_up_to_date(cached))
+	{
+		callback(cached, false);
+		return;
+	}
+
+	if (cached.tracks.empty())
+	{
+		load_all(spotify, cache, playlist, callback);
+		return;
+	}
+
+	spotify.playlist_track_ids(playlist,
+		[&spotify, &cache, playlist, cached, callback]
+		(const std::vector<lib::spt::track> &items)
+		{
+			const auto pages = changed_pages(cached.tracks, items, page_size);
+			lib::log::debug("Playlist {} changed, loading {} of {} pages", playlist.id,
+				pages.size(), (items.size() + page_size - 1) / page_size);
+
+			auto downloaded = std::make_shared<std::map<size_t, std::vector<lib::spt::track>>>();
+
+			auto merge_pages = [&spotify, &cache, playlist, cached, items, downloaded, callback]()
+			{
+				std::vector<lib::spt::track> tracks;
+				if (!merge(cached.tracks, items, *downloaded, page_size, tracks))
+				{
+					// Playlist changed again while loading
+					load_all(spotify, cache, playlist, callback);
+					return;
+				}
+
+				loaded(cache, playlist, tracks, callback);
+			};
+
+			if (pages.empty())
+			{
+				merge_pages();
+				return;
+			}
+
+			for (const auto page: pages)
+			{
+				spotify.playlist_tracks(playlist, page * page_size, page_size,
+					[page, pages, downloaded, merge_pages]
+					(const std::vector<lib::spt::track> &tracks)
+					{
+						(*downloaded)[page] = tracks;
+						if (downloaded->size() == pages.size())
+						{
+							merge_pages();
+						}
+					});
+			}
+		});
+}
+
+auto lib::spt::playlist_sync::changed_pages(const std::vector<lib::spt::track> &cached,
+	const std::vector<lib::spt::track> &items, size_t page_size) -> std::vector<size_t>
+{
+	const auto matches = match(cached, items);
+	std::vector<size_t> pages;
+
+	for (size_t i = 0; i < matches.size(); i++)
+	{
+		const auto page = i / page_size;
+		if (matches.at(i) < 0 && (pages.empty() || pages.back() != page))
+		{
+			pages.push_back(page);
+		}
+	}
+
+	return pages;
+}
+
+auto lib::spt::playlist_sync::merge(const std::vector<lib::spt::track> &cached,
+	const std::vector<lib::spt::track> &items,
+	const std::map<size_t, std::vector<lib::spt::track>> &pages,
+	size_t page_size, std::vector<lib::spt::track> &tracks) -> bool
+{
+	const auto matches = match(cached, items);
+	tracks.clear();
+	tracks.reserve(items.size());
+
+	for (size_t i = 0; i < matches.size(); i++)
+	{
+		const auto page = pages.find(i / page_size);
+		if (page == pages.end())
+		{
+			if (matches.at(i) < 0)
+			{
+				return false;
+			}
+
+			tracks.push_back(cached.at(matches.at(i)));
+			continue;
+		}
+
+		const auto index = i % page_size;
+		if (index >= page->second.size()
+			|| key(page->second.at(index)) != key(items.at(i)))
+		{
+			return false;
+		}
+
+		tracks.push_back(page->second.at(index));
+	}
+
+	return true;
+}
+
+auto lib::spt::playlist_sync::match(const std::vector<lib::spt::track> &cached,
+	const std::vector<lib::spt::track> &items) -> std::vector<long>
+{
+	std::unordered_map<std::string, std::deque<long>> available;
+	for (size_t i = 0; i < cached.size(); i++)
+	{
+		auto cached_key = key(cached.at(i));
+		if (!cached_key.empty())
+		{
+			available[cached_key].push_back(static_cast<long>(i));
+		}
+	}
+
+	std::vector<long> matches;
+	matches.reserve(items.size());
+
+	for (const auto &item: items)
+	{
+		const auto item_key = key(item);
+		auto iter = item_key.empty()
+			? available.end()
+			: available.find(item_key);
+
+		if (iter == available.end() || iter->second.empty())
+		{
+			matches.push_back(-1);
+			continue;
+		}
+
+		matches.push_back(iter->second.front());
+		iter->second.pop_front();
+	}
+
+	return matches;
+}
+
+auto lib::spt::playlist_sync::key(const lib::spt::track &track) -> std::string
+{
+	// Local files don't have an ID, so use name instead
+	if (track.id.empty())
+	{
+		return track.name.empty()
+			? std::string()
+			: lib::fmt::format("local:{} {}", track.name, track.added_at);
+	}
+
+	// Same track can be added multiple times, so match by added date as well
+	return lib::fmt::format("{} {}", track.id, track.added_at);
+}
+
+void lib::spt::playlist_sync::load_all(lib::spt::api &spotify, lib::cache &cache,
+	const lib::spt::playlist &playlist, const synced &callback)
+{
+	spotify.playlist_tracks(playlist, [&cache, playlist, callback]
+		(const std::vector<lib::spt::track> &tracks)
+	{
+		loaded(cache, playlist, tracks, callback);
+	});
+}
+
+void lib::spt::playlist_sync::loaded(lib::cache &cache, const lib::spt::playlist &playlist,
+	const std::vector<lib::spt::track> &tracks, const synced &callback)
+{
+	auto updated = playlist;
+	updated.tracks = tracks;
+	cache.set_playlist(updated);
+	callback(updated, true);
+}
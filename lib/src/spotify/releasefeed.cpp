@@ -0,0 +1,102 @@
+#include "lib/spotify/releasefeed.hpp"
+#include "lib/log.hpp"
+
+lib::spt::release_feed::release_feed(size_t max_requests, fetcher fetch)
+	: max_requests(max_requests > 0 ? max_requests : 1),
+	fetch(std::move(fetch))
+{
+}
+
+void lib::spt::release_feed::load(const std::vector<lib::spt::album> &releases,
+	const lib::playlist_index &index, size_t max_requests, const fetcher &fetch,
+	lib::callback<std::vector<lib::spt::track>> &callback)
+{
+	std::shared_ptr<release_feed> instance(new release_feed(max_requests, fetch));
+	instance->callback = callback;
+	instance->stopwatch.start();
+
+	for (const auto &album: releases)
+	{
+		if (index.has_artist(album.artist))
+		{
+			instance->albums.push_back(album);
+		}
+	}
+
+	// Newest first, and otherwise in the same order as returned
+	std::stable_sort(instance->albums.begin(), instance->albums.end(),
+		[](const lib::spt::album &album1, const lib::spt::album &album2) -> bool
+		{
+			return album1.release_date > album2.release_date;
+		});
+
+	instance->tracks.resize(instance->albums.size());
+
+	if (instance->albums.empty())
+	{
+		instance->finish();
+		return;
+	}
+
+	instance->request_albums();
+}
+
+void lib::spt::release_feed::request_albums()
+{
+	auto self = shared_from_this();
+
+	while (next_album < albums.size() && next_album - loaded_albums < max_requests)
+	{
+		const auto index = next_album++;
+		fetch(albums.at(index), [self, index](const std::vector<lib::spt::track> &results)
+		{
+			self->album_loaded(index, results);
+		});
+	}
+}
+
+void lib::spt::release_feed::album_loaded(size_t index,
+	const std::vector<lib::spt::track> &results)
+{
+	const auto &album = albums.at(index);
+	auto &album_tracks = tracks.at(index);
+
+	album_tracks.reserve(results.size());
+	for (const auto &result: results)
+	{
+		album_tracks.push_back(result);
+		album_tracks.back().added_at = album.release_date;
+	}
+
+	if (++loaded_albums >= albums.size())
+	{
+		finish();
+		return;
+	}
+
+	request_albums();
+}
+
+void lib::spt::release_feed::finish()
+{
+	size_t count = 0;
+	for (const auto &album_tracks: tracks)
+	{
+		count += album_tracks.size();
+	}
+
+	std::vector<lib::spt::track> results;
+	results.reserve(count);
+
+	for (auto &album_tracks: tracks)
+	{
+		std::move(album_tracks.begin(), album_tracks.end(), std::back_inserter(results));
+	}
+	tracks.clear();
+
+	stopwatch.stop();
+	lib::log::debug("Loaded {} tracks from {} new releases in {} ms", results.size(),
+		albums.size(), stopwatch.elapsed<lib::stopwatch::ms, long long>());
+
+	callback(results);
+}
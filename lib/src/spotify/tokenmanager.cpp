@@ -0,0 +1,178 @@
+#include "lib/spotify/tokenmanager.hpp"
+#include "lib/spotify/error.hpp"
+#include "lib/base64.hpp"
+#include "lib/datetime.hpp"
+
+lib::spt::token_manager::token_manager(lib::settings &settings,
+	const lib::http_client &http_client)
+	: settings(settings),
+	http(http_client)
+{
+}
+
+void lib::spt::token_manager::headers(lib::callback<lib::headers> &callback)
+{
+	const auto remaining = expires_in();
+
+	if (remaining > 0)
+	{
+		// Refresh ahead of time, without delaying this request
+		if (remaining <= refresh_margin)
+		{
+			request_refresh();
+		}
+
+		callback(current_headers());
+		return;
+	}
+
+	waiting.push_back(callback);
+	request_refresh();
+}
+
+void lib::spt::token_manager::refresh(lib::callback<std::string> &callback)
+{
+	refresh_callbacks.push_back(callback);
+	request_refresh();
+}
+
+void lib::spt::token_manager::refresh()
+{
+	if (settings.account.refresh_token.empty())
+	{
+		throw lib::spt::error("No refresh token", "token");
+	}
+
+	const auto response = http.post("https://accounts.spotify.com/api/token",
+		request_headers(), request_body());
+
+	const auto error = save_token(response);
+	if (!error.empty())
+	{
+		throw lib::spt::error(error, "token");
+	}
+}
+
+auto lib::spt::token_manager::expires_in() const -> long
+{
+	return settings.account.last_refresh + token_lifetime
+		- lib::date_time::seconds_since_epoch();
+}
+
+auto lib::spt::token_manager::is_refreshing() const -> bool
+{
+	return refreshing;
+}
+
+auto lib::spt::token_manager::current_headers() const -> lib::headers
+{
+	return {
+		{
+			"Authorization",
+			lib::fmt::format("Bearer {}", settings.account.access_token),
+		},
+	};
+}
+
+auto lib::spt::token_manager::request_headers() const -> lib::headers
+{
+	return {
+		{"Content-Type", "application/x-www-form-urlencoded"},
+		{"Authorization", lib::fmt::format("Basic {}",
+			lib::base64::encode(lib::fmt::format("{}:{}",
+				settings.account.client_id, settings.account.client_secret)))},
+	};
+}
+
+auto lib::spt::token_manager::request_body() const -> std::string
+{
+	return lib::fmt::format("grant_type=refresh_token&refresh_token={}",
+		settings.account.refresh_token);
+}
+
+void lib::spt::token_manager::request_refresh()
+{
+	if (refreshing)
+	{
+		return;
+	}
+
+	if (settings.account.refresh_token.empty())
+	{
+		refreshed(std::string());
+		return;
+	}
+
+	lib::log::debug("Refreshing access token, expires in {} seconds", expires_in());
+
+	refreshing = true;
+	http.post("https://accounts.spotify.com/api/token", request_body(), request_headers(),
+		[this](const std::string &response)
+		{
+			refreshed(response);
+		});
+}
+
+auto lib::spt::token_manager::save_token(const std::string &response) -> std::string
+{
+	if (response.empty())
+	{
+		return "No response";
+	}
+
+	nlohmann::json json;
+	try
+	{
+		json = nlohmann::json::parse(response);
+	}
+	catch (const std::exception &e)
+	{
+		return e.what();
+	}
+
+	if (!json.is_object() || !json.contains("access_token"))
+	{
+		std::string error;
+		lib::json::get(json, "error_description", error);
+		return error.empty() ? "No access token" : error;
+	}
+
+	settings.account.last_refresh = lib::date_time::seconds_since_epoch();
+	settings.account.access_token = json.at("access_token").get<std::string>();
+	settings.save();
+
+	return {};
+}
+
+void lib::spt::token_manager::refreshed(const std::string &response)
+{
+	refreshing = false;
+
+	auto error = settings.account.refresh_token.empty()
+		? std::string("No refresh token")
+		: save_token(response);
+
+	if (!error.empty())
+	{
+		lib::log::error("Refresh failed: {}", error);
+	}
+
+	// Callbacks may request another refresh
+	std::vector<std::function<void(const lib::headers &)>> requests;
+	requests.swap(waiting);
+
+	std::vector<std::function<void(const std::string &)>> callbacks;
+	callbacks.swap(refresh_callbacks);
+
+	// Replay requests even if refresh failed, to not leave them waiting forever
+	const auto headers = current_headers();
+	for (const auto &request: requests)
+	{
+		request(headers);
+	}
+
+	for (const auto &callback: callbacks)
+	{
+		callback(error);
+	}
+}
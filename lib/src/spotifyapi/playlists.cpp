@@ -44,12 +44,54 @@ void lib::spt::api::edit_playlist(const std::string &playlist_id,
 void lib::spt::api::playlist_tracks(const lib::spt::playlist &playlist,
 	lib::callback<std::vector<lib::spt::track>> &callback)
 {
-	auto fetch = [this, callback](const std::string &url)
+	playlist_tracks_url(playlist, [this, callback](const std::string &url)
 	{
-		auto item_url = lib::strings::contains(url, "market=")
+		get_items(url, callback);
+	});
+}
+
+void lib::spt::api::playlist_tracks(const lib::spt::playlist &playlist,
+	lib::paged<std::vector<lib::spt::track>> &callback)
+{
+	playlist_tracks_url(playlist, [this, callback](const std::string &url)
+	{
+		get_pages(url, callback);
+	});
+}
+
+void lib::spt::api::playlist_tracks(const lib::spt::playlist &playlist,
+	size_t offset, size_t limit, lib::callback<std::vector<lib::spt::track>> &callback)
+{
+	playlist_tracks_url(playlist, [this, offset, limit, callback](const std::string &url)
+	{
+		get_page(lib::fmt::format("{}&offset={}&limit={}", url, offset, limit),
+			[callback](const nlohmann::json &json)
+			{
+				callback(json.contains("items")
+					? json.at("items").get<std::vector<lib::spt::track>>()
+					: std::vector<lib::spt::track>());
+			});
+	});
+}
+
+void lib::spt::api::playlist_track_ids(const lib::spt::playlist &playlist,
+	lib::callback<std::vector<lib::spt::track>> &callback)
+{
+	playlist_tracks_url(playlist, [this, callback](const std::string &url)
+	{
+		get_items(lib::fmt::format("{}&offset=0&limit=100&fields={}", url,
+			"href,limit,next,offset,total,items(added_at,track(id,name))"), callback);
+	});
+}
+
+void lib::spt::api::playlist_tracks_url(const lib::spt::playlist &playlist,
+	lib::callback<std::string> &callback)
+{
+	auto fetch = [callback](const std::string &url)
+	{
+		callback(lib::strings::contains(url, "market=")
 			? url : lib::fmt::format("{}{}market=from_token",
-				url, lib::strings::contains(url, "?") ? "&" : "?");
-		get_items(item_url, callback);
+				url, lib::strings::contains(url, "?") ? "&" : "?"));
 	};
 
 	if (playlist.tracks_href.empty())
@@ -0,0 +1,170 @@
+#include "lib/writequeue.hpp"
+#include "lib/log.hpp"
+
+#include <fstream>
+
+lib::write_queue::write_queue()
+	: thread(&write_queue::run, this)
+{
+}
+
+lib::write_queue::~write_queue()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopped = true;
+	}
+
+	condition.notify_one();
+	thread.join();
+}
+
+auto lib::write_queue::get() -> write_queue &
+{
+	static write_queue queue;
+	return queue;
+}
+
+void lib::write_queue::write(const ghc::filesystem::path &path, serializer serialize)
+{
+	write(path, std::move(serialize), callback());
+}
+
+void lib::write_queue::write(const ghc::filesystem::path &path,
+	serializer serialize, callback written)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto &file = pending[path.string()];
+		file.serialize = std::move(serialize);
+		file.written = std::move(written);
+	}
+
+	condition.notify_one();
+}
+
+void lib::write_queue::remove(const ghc::filesystem::path &path)
+{
+	remove(path, callback());
+}
+
+void lib::write_queue::remove(const ghc::filesystem::path &path, callback removed)
+{
+	write(path, serializer(), std::move(removed));
+}
+
+void lib::write_queue::flush()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	written.wait(lock, [this]() -> bool
+	{
+		return pending.empty() && writing.empty();
+	});
+}
+
+void lib::write_queue::flush(const ghc::filesystem::path &path)
+{
+	const auto key = path.string();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	written.wait(lock, [this, &key]() -> bool
+	{
+		return pending.find(key) == pending.end()
+			&& writing.find(key) == writing.end();
+	});
+}
+
+auto lib::write_queue::write_atomic(const ghc::filesystem::path &path,
+	const std::string &data) -> bool
+{
+	auto temp_path = path;
+	temp_path += ".tmp";
+
+	{
+		std::ofstream file(temp_path.string(), std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			lib::log::warn("Failed to write \"{}\"", temp_path.string());
+			return false;
+		}
+
+		file.write(data.data(), static_cast<std::streamsize>(data.size()));
+		file.close();
+
+		if (file.fail())
+		{
+			lib::log::warn("Failed to write \"{}\"", temp_path.string());
+			return false;
+		}
+	}
+
+	std::error_code error;
+	ghc::filesystem::rename(temp_path, path, error);
+	if (error)
+	{
+		lib::log::warn("Failed to replace \"{}\": {}", path.string(), error.message());
+		ghc::filesystem::remove(temp_path, error);
+		return false;
+	}
+
+	return true;
+}
+
+auto lib::write_queue::is_temp(const ghc::filesystem::path &path) -> bool
+{
+	return path.extension() == ".tmp";
+}
+
+void lib::write_queue::run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while (true)
+	{
+		condition.wait(lock, [this]() -> bool
+		{
+			return stopped || !pending.empty();
+		});
+
+		if (pending.empty() && stopped)
+		{
+			return;
+		}
+
+		writing.swap(pending);
+		lock.unlock();
+
+		for (const auto &file: writing)
+		{
+			if (file.second.serialize)
+			{
+				try
+				{
+					write_atomic(file.first, file.second.serialize());
+				}
+				catch (const std::exception &e)
+				{
+					lib::log::warn("Failed to save \"{}\": {}", file.first, e.what());
+				}
+			}
+			else
+			{
+				std::error_code error;
+				ghc::filesystem::remove(file.first, error);
+				if (error)
+				{
+					lib::log::warn("Failed to remove \"{}\": {}", file.first, error.message());
+				}
+			}
+
+			if (file.second.written)
+			{
+				file.second.written();
+			}
+		}
+
+		lock.lock();
+		writing.clear();
+		written.notify_all();
+	}
+}
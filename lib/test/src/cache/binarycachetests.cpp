@@ -0,0 +1,102 @@
+#include "thirdparty/doctest.h"
+#include "lib/cache/binarycache.hpp"
+
+#include "testpaths.hpp"
+
+TEST_CASE("binary_cache")
+{
+	test_paths paths("binary-cache");
+	lib::binary_cache cache(paths);
+
+	std::vector<lib::spt::track> tracks(3);
+	for (size_t i = 0; i < tracks.size(); i++)
+	{
+		auto &track = tracks.at(i);
+		track.id = lib::fmt::format("track{}", i);
+		track.name = lib::fmt::format("Track {}", i);
+		track.duration = static_cast<int>(i * 1000);
+		track.added_at = "2021-01-01T00:00:00Z";
+		track.album = lib::spt::entity("album", "Album");
+		track.artists = {
+			lib::spt::entity("artist", "Artist"),
+		};
+	}
+
+	tracks.at(1).is_local = true;
+	tracks.at(1).artists.emplace_back("other", "Other Artist");
+	tracks.at(2).is_playable = false;
+
+	lib::spt::image image;
+	image.url = "https://image";
+	image.width = 64;
+	image.height = 32;
+	tracks.at(2).images.push_back(image);
+
+	auto check_tracks = [&tracks](const std::vector<lib::spt::track> &result)
+	{
+		REQUIRE_EQ(result.size(), tracks.size());
+		for (size_t i = 0; i < tracks.size(); i++)
+		{
+			nlohmann::json expected = tracks.at(i);
+			nlohmann::json actual = result.at(i);
+			CHECK_EQ(actual, expected);
+		}
+	};
+
+	SUBCASE("serialize")
+	{
+		const auto data = lib::binary_cache::serialize(tracks);
+		check_tracks(lib::binary_cache::deserialize(data));
+
+		// Repeated names are only stored once
+		std::vector<lib::spt::track> repeated(100, tracks.front());
+		CHECK_LT(lib::binary_cache::serialize(repeated).size(),
+			nlohmann::json(repeated).dump().size() / 4);
+	}
+
+	SUBCASE("invalid")
+	{
+		CHECK(lib::binary_cache::deserialize({}).empty());
+		CHECK(lib::binary_cache::deserialize({1, 2, 3, 4, 5, 6, 7, 8}).empty());
+
+		auto data = lib::binary_cache::serialize(tracks);
+		data.resize(data.size() - 1);
+		CHECK(lib::binary_cache::deserialize(data).empty());
+	}
+
+	SUBCASE("get_tracks")
+	{
+		CHECK(cache.get_tracks("playlist").empty());
+
+		cache.set_tracks("playlist", tracks);
+		check_tracks(cache.get_tracks("playlist"));
+
+		const auto all = cache.all_tracks();
+		REQUIRE_EQ(all.size(), 1);
+		check_tracks(all.at("playlist"));
+
+		// Saved in the background
+		lib::write_queue::get().flush();
+		CHECK(ghc::filesystem::exists(paths.cache() / "tracks" / "playlist.bin"));
+		check_tracks(lib::binary_cache(paths).get_tracks("playlist"));
+	}
+
+	SUBCASE("migrate")
+	{
+		lib::json_cache json_cache(paths);
+		json_cache.set_tracks("playlist", tracks);
+		json_cache.set_tracks("album", tracks);
+
+		// Migrated while still saving as JSON
+		check_tracks(cache.get_tracks("playlist"));
+
+		lib::write_queue::get().flush();
+		CHECK_FALSE(ghc::filesystem::exists(paths.cache() / "tracks" / "playlist.json"));
+		CHECK(ghc::filesystem::exists(paths.cache() / "tracks" / "playlist.bin"));
+
+		const auto all = cache.all_tracks();
+		REQUIRE_EQ(all.size(), 2);
+		check_tracks(all.at("album"));
+		CHECK(json_cache.get_tracks("album").empty());
+	}
+}
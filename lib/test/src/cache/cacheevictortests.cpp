@@ -0,0 +1,70 @@
+#include "thirdparty/doctest.h"
+#include "lib/cache/cacheevictor.hpp"
+#include "lib/log.hpp"
+
+#include <fstream>
+
+TEST_CASE("cache_evictor")
+{
+	lib::log::set_log_to_stdout(false);
+
+	const auto directory = ghc::filesystem::temp_directory_path() / "spotify-qt-cache-evictor";
+	ghc::filesystem::remove_all(directory);
+	ghc::filesystem::create_directories(directory);
+
+	constexpr size_t file_size = 1000;
+	const auto now = ghc::filesystem::file_time_type::clock::now();
+
+	// file0 is the least recently used
+	for (auto i = 0; i < 10; i++)
+	{
+		const auto path = directory / lib::fmt::format("file{}", i);
+		std::ofstream file(path.string(), std::ios::binary);
+		file << std::string(file_size, 'a');
+		file.close();
+
+		ghc::filesystem::last_write_time(path, now - std::chrono::hours(10 - i));
+	}
+
+	SUBCASE("within limit")
+	{
+		lib::cache_evictor evictor(directory, 20 * file_size, std::chrono::milliseconds(0));
+		const auto stats = evictor.evict();
+		CHECK_EQ(stats.size, 10 * file_size);
+		CHECK_EQ(stats.files, 10);
+		CHECK_EQ(stats.evicted_files, 0);
+	}
+
+	SUBCASE("unlimited")
+	{
+		lib::cache_evictor evictor(directory, 0, std::chrono::milliseconds(0));
+		CHECK_EQ(evictor.evict().evicted_files, 0);
+	}
+
+	SUBCASE("evict")
+	{
+		// Recently used file is kept
+		lib::cache_evictor::touch(directory / "file1");
+
+		lib::cache_evictor evictor(directory, 5 * file_size, std::chrono::milliseconds(0));
+		const auto stats = evictor.evict();
+
+		// Removed until 90% of limit
+		CHECK_EQ(stats.files, 4);
+		CHECK_EQ(stats.size, 4 * file_size);
+		CHECK_EQ(stats.evicted_files, 6);
+		CHECK_EQ(stats.evicted_bytes, 6 * file_size);
+
+		CHECK_FALSE(ghc::filesystem::exists(directory / "file0"));
+		CHECK(ghc::filesystem::exists(directory / "file1"));
+		CHECK(ghc::filesystem::exists(directory / "file9"));
+
+		// Changing limit
+		evictor.set_max_size(2 * file_size);
+		CHECK_EQ(evictor.get_max_size(), 2 * file_size);
+		CHECK_EQ(evictor.evict().evicted_files, 9);
+		CHECK_EQ(evictor.get_stats().files, 1);
+	}
+
+	ghc::filesystem::remove_all(directory);
+}
@@ -0,0 +1,44 @@
+#include "thirdparty/doctest.h"
+#include "lib/cache/databasecache.hpp"
+
+#include "testpaths.hpp"
+
+TEST_CASE("database_cache")
+{
+	test_paths paths("database-cache");
+
+	lib::spt::playlist playlist;
+	playlist.id = "playlist";
+	playlist.name = "Playlist";
+
+	lib::spt::track track;
+	track.id = "track";
+	track.name = "Track";
+	track.added_at = "1970-01-02T00:00:00Z";
+	playlist.tracks.push_back(track);
+
+	{
+		lib::database_cache cache(paths);
+		CHECK(cache.get_playlists().empty());
+		CHECK(cache.all_tracks().empty());
+
+		cache.set_playlists({playlist});
+		cache.set_playlist(playlist);
+		cache.set_tracks(playlist.id, {track});
+	}
+
+	// Everything except album images is in a single file
+	CHECK(ghc::filesystem::exists(paths.cache() / "cache.db"));
+	CHECK_FALSE(ghc::filesystem::exists(paths.cache() / "playlist"));
+	CHECK_FALSE(ghc::filesystem::exists(paths.cache() / "tracks"));
+
+	lib::database_cache cache(paths);
+	CHECK_EQ(cache.get_playlists().size(), 1);
+	CHECK_EQ(cache.get_playlist(playlist.id).name, playlist.name);
+	CHECK_EQ(cache.get_playlist_index().latest_added(playlist.id), 86400);
+
+	const auto all_tracks = cache.all_tracks();
+	REQUIRE_EQ(all_tracks.size(), 1);
+	REQUIRE_EQ(all_tracks.at(playlist.id).size(), 1);
+	CHECK_EQ(all_tracks.at(playlist.id).front().name, track.name);
+}
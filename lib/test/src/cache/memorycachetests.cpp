@@ -0,0 +1,215 @@
+#include "thirdparty/doctest.h"
+#include "lib/cache/memorycache.hpp"
+
+/**
+ * Cache that only keeps tracks, and counts reads and writes
+ */
+class counting_cache: public lib::cache
+{
+public:
+	counting_cache(int &reads, int &writes)
+		: reads(reads),
+		writes(writes)
+	{
+	}
+
+	auto get_album_image(const std::string &/*url*/) const -> std::vector<unsigned char> override
+	{
+		return {};
+	}
+
+	auto get_album_image_path(const std::string &/*url*/) const -> std::string override
+	{
+		return {};
+	}
+
+	void set_album_image(const std::string &/*url*/,
+		const std::vector<unsigned char> &/*data*/) override
+	{
+	}
+
+	auto get_album(const std::string &/*album_id*/) const -> lib::spt::album override
+	{
+		return {};
+	}
+
+	void set_album(const lib::spt::album &/*album*/) override
+	{
+	}
+
+	auto get_playlists() const -> std::vector<lib::spt::playlist> override
+	{
+		return {};
+	}
+
+	void set_playlists(const std::vector<lib::spt::playlist> &/*playlists*/) override
+	{
+	}
+
+	auto get_playlist(const std::string &/*playlist_id*/) const -> lib::spt::playlist override
+	{
+		return {};
+	}
+
+	void set_playlist(const lib::spt::playlist &/*playlist*/) override
+	{
+	}
+
+	auto get_playlist_index() const -> const lib::playlist_index & override
+	{
+		return index;
+	}
+
+	auto get_tracks(const std::string &entity_id) const -> std::vector<lib::spt::track> override
+	{
+		reads++;
+		const auto item = tracks.find(entity_id);
+		return item == tracks.end()
+			? std::vector<lib::spt::track>()
+			: item->second;
+	}
+
+	void set_tracks(const std::string &entity_id,
+		const std::vector<lib::spt::track> &items) override
+	{
+		writes++;
+		tracks[entity_id] = items;
+	}
+
+	auto all_tracks() const -> std::map<std::string, std::vector<lib::spt::track>> override
+	{
+		return tracks;
+	}
+
+	auto get_track_info(const lib::spt::track &/*track*/) const -> lib::spt::track_info override
+	{
+		return {};
+	}
+
+	void set_track_info(const lib::spt::track &/*track*/,
+		const lib::spt::track_info &/*track_info*/) override
+	{
+	}
+
+	void add_crash(const lib::crash_info &/*info*/) override
+	{
+	}
+
+	auto get_all_crashes() const -> std::vector<lib::crash_info> override
+	{
+		return {};
+	}
+
+private:
+	int &reads;
+	int &writes;
+	std::map<std::string, std::vector<lib::spt::track>> tracks;
+	lib::playlist_index index;
+};
+
+TEST_CASE("memory_cache")
+{
+	auto reads = 0;
+	auto writes = 0;
+	const std::chrono::hours write_delay(1);
+
+	auto make_cache = [&](size_t max_size) -> lib::memory_cache *
+	{
+		return new lib::memory_cache(std::unique_ptr<lib::cache>(new counting_cache(reads, writes)),
+			max_size, write_delay);
+	};
+
+	std::vector<lib::spt::track> tracks(3);
+
+	SUBCASE("get")
+	{
+		std::unique_ptr<lib::memory_cache> cache(make_cache(10));
+
+		cache->set_tracks("a", tracks);
+		CHECK_EQ(cache->get_tracks("a").size(), tracks.size());
+		CHECK_EQ(reads, 0);
+
+		CHECK(cache->get_tracks("b").empty());
+		CHECK(cache->get_tracks("b").empty());
+		CHECK_EQ(reads, 1);
+	}
+
+	SUBCASE("evict")
+	{
+		std::unique_ptr<lib::memory_cache> cache(make_cache(10));
+
+		cache->set_tracks("a", tracks);
+		cache->set_tracks("b", tracks);
+		cache->set_tracks("c", tracks);
+
+		// Least recently used is evicted, but pending change is written before reading
+		CHECK_EQ(cache->get_tracks("a").size(), tracks.size());
+		CHECK_EQ(reads, 1);
+		CHECK_EQ(writes, 1);
+	}
+
+	SUBCASE("write")
+	{
+		std::unique_ptr<lib::memory_cache> cache(make_cache(10));
+
+		// Only latest change is written
+		cache->set_tracks("a", {});
+		cache->set_tracks("a", tracks);
+		CHECK_EQ(writes, 0);
+
+		cache->flush();
+		CHECK_EQ(writes, 1);
+
+		cache->set_tracks("b", tracks);
+		cache.reset();
+		CHECK_EQ(writes, 2);
+	}
+
+	SUBCASE("all_tracks")
+	{
+		std::unique_ptr<lib::memory_cache> cache(make_cache(10));
+		cache->set_tracks("a", tracks);
+		CHECK_EQ(cache->all_tracks().size(), 1);
+	}
+
+	SUBCASE("crash")
+	{
+		std::unique_ptr<lib::memory_cache> cache(make_cache(10));
+		cache->set_tracks("a", tracks);
+
+		// Pending changes aren't written when crashing
+		cache->add_crash(lib::crash_info());
+		CHECK_EQ(writes, 0);
+	}
+
+	SUBCASE("listeners")
+	{
+		std::unique_ptr<lib::memory_cache> cache(make_cache(10));
+
+		std::vector<std::string> changed;
+		cache->on_tracks_changed([&changed](const std::string &entity_id,
+			const std::vector<lib::spt::track> &items)
+		{
+			changed.push_back(lib::fmt::format("tracks/{}/{}", entity_id, items.size()));
+		});
+		cache->on_playlist_changed([&changed](const lib::spt::playlist &playlist)
+		{
+			changed.push_back(lib::fmt::format("playlist/{}", playlist.id));
+		});
+		cache->on_playlists_changed([&changed](const std::vector<lib::spt::playlist> &items)
+		{
+			changed.push_back(lib::fmt::format("playlists/{}", items.size()));
+		});
+
+		lib::spt::playlist playlist;
+		playlist.id = "a";
+
+		cache->set_tracks("a", tracks);
+		cache->set_playlist(playlist);
+		cache->set_playlists({playlist});
+
+		CHECK_EQ(changed, std::vector<std::string>{
+			"tracks/a/3", "playlist/a", "playlists/1",
+		});
+	}
+}
@@ -0,0 +1,63 @@
+#include "thirdparty/doctest.h"
+#include "lib/cache/playlistindex.hpp"
+
+TEST_CASE("playlist_index")
+{
+	lib::spt::playlist playlist;
+	playlist.id = "playlist";
+	playlist.tracks.resize(3);
+	playlist.tracks.at(0).added_at = "2021-01-01T00:00:00Z";
+	playlist.tracks.at(1).added_at = "2021-03-04T05:06:07Z";
+	playlist.tracks.at(0).artists.emplace_back("artist1", "Artist 1");
+	playlist.tracks.at(1).artists.emplace_back("artist1", "Artist 1");
+	playlist.tracks.at(2).artists.emplace_back("artist2", "Artist 2");
+
+	lib::playlist_index index;
+
+	SUBCASE("latest_added")
+	{
+		CHECK_EQ(index.latest_added(playlist.id), 0);
+
+		index.update(playlist);
+		CHECK_EQ(index.latest_added(playlist.id), 1614834367);
+
+		playlist.tracks.clear();
+		index.update(playlist);
+		CHECK_EQ(index.latest_added(playlist.id), 0);
+		CHECK_EQ(index.size(), 1);
+	}
+
+	SUBCASE("artist_playlists")
+	{
+		CHECK_FALSE(index.has_artist("Artist 1"));
+
+		index.update(playlist);
+
+		auto other = playlist;
+		other.id = "other";
+		other.tracks.pop_back();
+		index.update(other);
+
+		CHECK(index.has_artist("Artist 1"));
+		CHECK_EQ(index.artist_playlists("Artist 1").size(), 2);
+		CHECK_EQ(index.artist_playlists("Artist 2"), std::vector<std::string>{
+			playlist.id,
+		});
+
+		// Artists removed from playlist are removed from index
+		playlist.tracks.pop_back();
+		index.update(playlist);
+		CHECK_FALSE(index.has_artist("Artist 2"));
+		CHECK(index.artist_playlists("Artist 2").empty());
+	}
+
+	SUBCASE("json")
+	{
+		index.update(playlist);
+
+		const nlohmann::json json = index;
+		const auto parsed = json.get<lib::playlist_index>();
+		CHECK_EQ(parsed.latest_added(playlist.id), 1614834367);
+		CHECK(parsed.has_artist("Artist 2"));
+	}
+}
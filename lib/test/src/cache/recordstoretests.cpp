@@ -0,0 +1,134 @@
+#include "thirdparty/doctest.h"
+#include "lib/cache/recordstore.hpp"
+#include "lib/log.hpp"
+
+#include <fstream>
+
+TEST_CASE("record_store")
+{
+	lib::log::set_log_to_stdout(false);
+
+	const auto path = ghc::filesystem::temp_directory_path() / "spotify-qt-record-store.db";
+	ghc::filesystem::remove(path);
+
+	auto value = [](const std::string &str) -> std::vector<unsigned char>
+	{
+		return {str.cbegin(), str.cend()};
+	};
+
+	SUBCASE("get")
+	{
+		lib::record_store store(path, 2);
+		CHECK(store.get("key").empty());
+
+		// Pending
+		store.put("key", value("value"));
+		CHECK_EQ(store.get("key"), value("value"));
+
+		// Committed
+		store.put("other", value("other"));
+		CHECK_EQ(store.get("key"), value("value"));
+		CHECK_EQ(store.get("other"), value("other"));
+
+		store.put("key", value("new value"));
+		CHECK_EQ(store.get("key"), value("new value"));
+	}
+
+	SUBCASE("reopen")
+	{
+		{
+			lib::record_store store(path, 10);
+			store.put("key", value("value"));
+			store.put("key", value("new value"));
+			store.put("other", value("other"));
+		}
+
+		lib::record_store store(path, 10);
+		CHECK_EQ(store.get("key"), value("new value"));
+		CHECK_EQ(store.get("other"), value("other"));
+	}
+
+	SUBCASE("keys")
+	{
+		lib::record_store store(path, 2);
+		store.put("tracks/a", value("a"));
+		store.put("tracks/c", value("c"));
+		store.put("tracks/b", value("b"));
+		store.put("track_info/a", value("a"));
+
+		const std::vector<std::string> expected{
+			"tracks/a", "tracks/b", "tracks/c",
+		};
+		CHECK_EQ(store.keys("tracks/"), expected);
+	}
+
+	SUBCASE("incomplete")
+	{
+		{
+			lib::record_store store(path, 1);
+			store.put("first", value("first"));
+			store.put("second", value("second"));
+		}
+
+		// Simulate crash while writing last record
+		ghc::filesystem::resize_file(path, ghc::filesystem::file_size(path) - 2);
+
+		lib::record_store store(path, 1);
+		CHECK_EQ(store.get("first"), value("first"));
+		CHECK(store.get("second").empty());
+
+		store.put("third", value("third"));
+		CHECK_EQ(store.get("third"), value("third"));
+	}
+
+	SUBCASE("compact")
+	{
+		const std::vector<unsigned char> large(1024 * 64, 'a');
+
+		{
+			lib::record_store store(path, 1);
+			for (auto i = 0; i < 64; i++)
+			{
+				store.put("key", large);
+			}
+			store.put("other", value("other"));
+		}
+
+		const auto size = ghc::filesystem::file_size(path);
+
+		lib::record_store store(path, 1);
+		CHECK_LT(ghc::filesystem::file_size(path), size / 10);
+		CHECK_EQ(store.get("key"), large);
+		CHECK_EQ(store.get("other"), value("other"));
+	}
+
+	SUBCASE("compact corrupt")
+	{
+		const std::vector<unsigned char> large(1024 * 64, 'a');
+
+		{
+			lib::record_store store(path, 1);
+			for (auto i = 0; i < 64; i++)
+			{
+				store.put("key", large);
+			}
+			store.put("other", value("other"));
+		}
+
+		// Change last byte of last value
+		{
+			std::fstream file(path.string(), std::ios::in | std::ios::out | std::ios::binary);
+			file.seekp(-1, std::ios::end);
+			file.put('x');
+		}
+
+		lib::record_store store(path, 1);
+		CHECK_EQ(store.get("key"), large);
+		CHECK(store.get("other").empty());
+		CHECK_EQ(store.keys(std::string()), std::vector<std::string>{
+			"key",
+		});
+	}
+
+	ghc::filesystem::remove(path);
+}
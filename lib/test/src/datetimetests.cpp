@@ -62,4 +62,11 @@ TEST_CASE("date_time")
 		date_time = lib::date_time(2008, 9, 10, 11, 12, 14);
 		CHECK_EQ(date_time.to_iso_date_time(), "2008-09-10T11:12:14Z");
 	}
+
+	SUBCASE("to_epoch")
+	{
+		CHECK_EQ(lib::date_time().to_epoch(), 0);
+		CHECK_EQ(lib::date_time(1970, 1, 2, 0, 0, 0).to_epoch(), 86400);
+		CHECK_EQ(lib::date_time::parse("2021-03-04T05:06:07Z").to_epoch(), 1614834367);
+	}
 }
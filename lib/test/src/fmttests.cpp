@@ -1,5 +1,8 @@
 #include "thirdparty/doctest.h"
 #include "lib/fmt.hpp"
+#include "lib/stopwatch.hpp"
+
+#include <limits>
 
 TEST_CASE("fmt::format")
 {
@@ -10,6 +13,15 @@ TEST_CASE("fmt::format")
 		CHECK_EQ(lib::fmt::format("[{}, {}, {}]", 1, 2, 3, 4), "[1, 2, 3]");
 	}
 
+	SUBCASE("format")
+	{
+		CHECK_EQ(lib::fmt::format(std::string("{}/{}"), "a", "b"), "a/b");
+		CHECK_EQ(lib::fmt::format("{}", 1), "1");
+		CHECK_EQ(lib::fmt::format("{{}}", 1), "{1}");
+		CHECK_EQ(lib::fmt::format("{ } {", 1), "{ } {");
+		CHECK_EQ(lib::fmt::format("", 1), "");
+	}
+
 	SUBCASE("string")
 	{
 		CHECK_EQ(lib::fmt::format("string: {}", std::string("value")), "string: value");
@@ -34,10 +46,33 @@ TEST_CASE("fmt::format")
 		CHECK_EQ(lib::fmt::format("int: {}", val), "int: 2147483647");
 	}
 
+	SUBCASE("negative int")
+	{
+		CHECK_EQ(lib::fmt::format("int: {}", -42), "int: -42");
+		CHECK_EQ(lib::fmt::format("int: {}", 0), "int: 0");
+		CHECK_EQ(lib::fmt::format("int: {}", std::numeric_limits<int>::min()),
+			"int: -2147483648");
+	}
+
+	SUBCASE("unsigned")
+	{
+		constexpr size_t val = 18446744073709551615ULL;
+		CHECK_EQ(lib::fmt::format("size_t: {}", val), "size_t: 18446744073709551615");
+		CHECK_EQ(lib::fmt::format("unsigned short: {}", static_cast<unsigned short>(65535)),
+			"unsigned short: 65535");
+	}
+
+	SUBCASE("char")
+	{
+		CHECK_EQ(lib::fmt::format("char: {}", 'a'), "char: a");
+	}
+
 	SUBCASE("long long")
 	{
 		constexpr long long val = 9223372036854775807;
 		CHECK_EQ(lib::fmt::format("long long: {}", val), "long long: 9223372036854775807");
+		CHECK_EQ(lib::fmt::format("long long: {}", std::numeric_limits<long long>::min()),
+			"long long: -9223372036854775808");
 	}
 
 	SUBCASE("float")
@@ -62,3 +97,85 @@ TEST_CASE("fmt::format")
 		CHECK_EQ(lib::fmt::format("json: {}", val), R"(json: {"a":1,"b":2})");
 	}
 }
+
+namespace
+{
+	/**
+	 * Previous implementation, formatting through a stream
+	 */
+	void stream_format(const std::string &str, std::stringstream &stream, size_t &index)
+	{
+		stream << str.substr(index);
+	}
+
+	template<typename Arg, typename... Args>
+	void stream_format(const std::string &str, std::stringstream &stream, size_t &index,
+		const Arg &arg, Args &&... args)
+	{
+		const auto next = str.find("{}", index);
+		if (next == std::string::npos)
+		{
+			stream << str.substr(index);
+			index = str.size();
+		}
+		else
+		{
+			stream << str.substr(index, next - index) << arg;
+			index = next + 2;
+		}
+
+		stream_format(str, stream, index, args...);
+	}
+
+	template<typename Format, typename... Args>
+	auto stream_format(const Format &str, Args &&... args) -> std::string
+	{
+		std::stringstream stream;
+		size_t index = 0;
+		stream_format(std::string(str), stream, index, args...);
+		return stream.str();
+	}
+}
+
+TEST_CASE("fmt::format benchmark" * doctest::skip())
+{
+	constexpr int iterations = 1000000;
+
+	const std::string device = "0d1841b0976bae2a3a310dd74c0f3df354899bc8";
+	const std::string token = "BQDx0yT7Pdt4n2LrR9mJkC3Zqf1Ws6vHuEgYaNbKoM5pIcVlXj8sAe";
+
+	auto run = [&](const char *name, std::string (*format)(int, const std::string &,
+		const std::string &))
+	{
+		size_t length = 0;
+
+		lib::stopwatch stopwatch;
+		stopwatch.start();
+
+		for (auto i = 0; i < iterations; i++)
+		{
+			length += format(i, device, token).size();
+		}
+
+		stopwatch.stop();
+		MESSAGE(lib::fmt::format("{}: {} ms ({} bytes)", name,
+			stopwatch.elapsed<lib::stopwatch::ms, long long>(), length));
+	};
+
+	run("stringstream", [](int i, const std::string &device,
+		const std::string &token) -> std::string
+	{
+		return stream_format("me/player/play?device_id={}&offset={}", device, i)
+			+ stream_format("Bearer {}", token);
+	});
+
+	run("fmt::format", [](int i, const std::string &device,
+		const std::string &token) -> std::string
+	{
+		return lib::fmt::format("me/player/play?device_id={}&offset={}", device, i)
+			+ lib::fmt::format("Bearer {}", token);
+	});
+
+	CHECK_EQ(lib::fmt::format("me/player/play?device_id={}&offset={}", device, 42),
+		stream_format("me/player/play?device_id={}&offset={}", device, 42));
+}
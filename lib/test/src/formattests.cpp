@@ -18,5 +18,6 @@ TEST_CASE("fmt::format")
 		CHECK_EQ(lib::format::size(1000), "1 kB");
 		CHECK_EQ(lib::format::size(1000000), "1 MB");
 		CHECK_EQ(lib::format::size(1000000000), "1 GB");
+		CHECK_EQ(lib::format::size(5000000000ULL), "5 GB");
 	}
 }
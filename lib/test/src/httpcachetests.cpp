@@ -0,0 +1,108 @@
+#include "thirdparty/doctest.h"
+#include "lib/httpcache.hpp"
+
+TEST_CASE("http_cache")
+{
+	const std::string url = "https://api.spotify.com/v1/me/playlists";
+	const nlohmann::json json{
+		{"items", {1, 2, 3}},
+	};
+
+	auto response = [&json](int status, const lib::headers &headers) -> lib::http_response
+	{
+		lib::http_response result;
+		result.status = status;
+		result.headers = headers;
+		result.body = status == 200 ? json.dump() : std::string();
+		return result;
+	};
+
+	lib::http_cache cache(1024);
+	nlohmann::json cached;
+	lib::headers headers;
+
+	SUBCASE("etag")
+	{
+		cache.set(url, response(200, {
+			{"etag", "\"abc\""},
+			{"cache-control", "private, max-age=0"},
+		}), json);
+
+		CHECK_FALSE(cache.get_fresh(url, cached));
+
+		cache.add_headers(url, headers);
+		CHECK_EQ(headers.at("If-None-Match"), "\"abc\"");
+
+		REQUIRE(cache.get_not_modified(url, response(304, {}), cached));
+		CHECK_EQ(cached, json);
+
+		// ETag is kept after a not modified response without one
+		headers.clear();
+		cache.add_headers(url, headers);
+		CHECK_EQ(headers.at("If-None-Match"), "\"abc\"");
+
+		CHECK_FALSE(cache.get_not_modified(url, response(200, {}), cached));
+		CHECK_FALSE(cache.get_not_modified("https://api.spotify.com/v1/me", response(304, {}),
+			cached));
+
+		CHECK_EQ(cache.get_stats().revalidated, 1);
+		CHECK_EQ(cache.get_stats().misses, 1);
+
+		// Not conditional once removed
+		cache.remove(url);
+		CHECK_FALSE(cache.get_not_modified(url, response(304, {}), cached));
+		headers.clear();
+		cache.add_headers(url, headers);
+		CHECK(headers.empty());
+	}
+
+	SUBCASE("max-age")
+	{
+		cache.set(url, response(200, {
+			{"cache-control", "public, max-age=3600"},
+		}), json);
+
+		REQUIRE(cache.get_fresh(url, cached));
+		CHECK_EQ(cached, json);
+
+		cache.add_headers(url, headers);
+		CHECK(headers.empty());
+
+		cache.expire();
+		CHECK_FALSE(cache.get_fresh(url, cached));
+		CHECK_EQ(cache.get_stats().fresh, 1);
+		CHECK_EQ(cache.get_stats().saved_bytes, json.dump().size());
+	}
+
+	SUBCASE("not stored")
+	{
+		cache.set(url, response(200, {
+			{"etag", "\"abc\""},
+			{"cache-control", "no-store"},
+		}), json);
+		cache.add_headers(url, headers);
+		CHECK(headers.empty());
+
+		cache.set(url, response(200, {}), json);
+		cache.add_headers(url, headers);
+		CHECK(headers.empty());
+
+		cache.set(url, response(404, {
+			{"etag", "\"abc\""},
+		}), json);
+		cache.add_headers(url, headers);
+		CHECK(headers.empty());
+	}
+
+	SUBCASE("no-cache")
+	{
+		cache.set(url, response(200, {
+			{"etag", "\"abc\""},
+			{"cache-control", "max-age=60, no-cache"},
+		}), json);
+
+		CHECK_FALSE(cache.get_fresh(url, cached));
+		cache.add_headers(url, headers);
+		CHECK_EQ(headers.size(), 1);
+	}
+}
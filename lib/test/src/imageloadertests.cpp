@@ -0,0 +1,138 @@
+#include "thirdparty/doctest.h"
+#include "lib/imageloader.hpp"
+#include "lib/cache/jsoncache.hpp"
+
+#include "testpaths.hpp"
+
+#include <deque>
+
+/**
+ * HTTP client that only replies to GET requests when asked to
+ */
+class queued_http_client: public lib::http_client
+{
+public:
+	mutable std::deque<std::pair<std::string, std::function<void(const std::string &)>>> queue;
+
+	void get(const std::string &url, const lib::headers &/*headers*/,
+		lib::callback<std::string> &callback) const override
+	{
+		queue.emplace_back(url, callback);
+	}
+
+	void put(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &/*callback*/) const override
+	{
+	}
+
+	void post(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &/*callback*/) const override
+	{
+	}
+
+	auto post(const std::string &/*url*/, const lib::headers &/*headers*/,
+		const std::string &/*post_data*/) const -> std::string override
+	{
+		return {};
+	}
+
+	void del(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &/*callback*/) const override
+	{
+	}
+
+	/**
+	 * Reply to oldest request
+	 */
+	void reply(const std::string &data)
+	{
+		auto request = queue.front();
+		queue.pop_front();
+		request.second(data);
+	}
+};
+
+TEST_CASE("image_loader")
+{
+	test_paths paths("image-loader");
+	lib::json_cache cache(paths);
+	queued_http_client http_client;
+	lib::image_loader loader(http_client, cache, 2);
+
+	const std::string jpeg = "\xff\xd8\xff\xe0";
+
+	SUBCASE("deduplicate")
+	{
+		auto loaded = 0;
+		auto callback = [&loaded](const std::vector<unsigned char> &data)
+		{
+			CHECK_EQ(data.size(), 4);
+			loaded++;
+		};
+
+		for (auto i = 0; i < 3; i++)
+		{
+			loader.get("https://i.scdn.co/image/a", callback);
+		}
+
+		CHECK_EQ(http_client.queue.size(), 1);
+		http_client.reply(jpeg);
+		CHECK_EQ(loaded, 3);
+
+		// Now loaded from cache
+		CHECK(loader.is_cached("https://i.scdn.co/image/a"));
+		loader.get("https://i.scdn.co/image/a", callback);
+		CHECK(http_client.queue.empty());
+		CHECK_EQ(loaded, 4);
+
+		const auto &stats = loader.get_stats();
+		CHECK_EQ(stats.hits, 1);
+		CHECK_EQ(stats.misses, 1);
+		CHECK_EQ(stats.deduplicated, 2);
+		CHECK_EQ(stats.failed, 0);
+	}
+
+	SUBCASE("per host limit")
+	{
+		std::vector<std::string> loaded;
+		for (auto i = 0; i < 5; i++)
+		{
+			const auto url = lib::fmt::format("https://i.scdn.co/image/{}", i);
+			loader.get(url, [&loaded, url](const std::vector<unsigned char> &/*data*/)
+			{
+				loaded.push_back(url);
+			});
+		}
+		loader.get("https://mosaic.scdn.co/image", [](const std::vector<unsigned char> &)
+		{
+		});
+
+		// Two from first host, one from the other
+		CHECK_EQ(http_client.queue.size(), 3);
+
+		while (!http_client.queue.empty())
+		{
+			CHECK_LE(http_client.queue.size(), 3);
+			http_client.reply(jpeg);
+		}
+
+		REQUIRE_EQ(loaded.size(), 5);
+		CHECK_EQ(loaded.front(), "https://i.scdn.co/image/0");
+		CHECK_EQ(loaded.back(), "https://i.scdn.co/image/4");
+	}
+
+	SUBCASE("invalid")
+	{
+		auto loaded = false;
+		loader.get("https://i.scdn.co/image/b", [&loaded](const std::vector<unsigned char> &data)
+		{
+			CHECK(data.empty());
+			loaded = true;
+		});
+
+		http_client.reply("<html></html>");
+		CHECK(loaded);
+		CHECK_FALSE(loader.is_cached("https://i.scdn.co/image/b"));
+		CHECK_EQ(loader.get_stats().failed, 1);
+	}
+}
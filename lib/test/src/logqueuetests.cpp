@@ -0,0 +1,89 @@
+#include "thirdparty/doctest.h"
+#include "lib/logqueue.hpp"
+#include "lib/fmt.hpp"
+
+#include <map>
+
+TEST_CASE("log_queue")
+{
+	std::vector<lib::log_message> messages;
+
+	SUBCASE("flush")
+	{
+		lib::log_queue queue([&messages](const lib::log_message &message)
+		{
+			messages.push_back(message);
+		});
+
+		queue.push(lib::log_type::warning, "hello");
+		queue.push(lib::log_type::error, "world");
+		queue.flush();
+
+		REQUIRE_EQ(messages.size(), 2);
+		CHECK_EQ(messages.at(0).get_message(), "hello");
+		CHECK_EQ(messages.at(0).get_log_type(), lib::log_type::warning);
+		CHECK_EQ(messages.at(1).get_message(), "world");
+		CHECK_FALSE(messages.at(1).get_time().empty());
+	}
+
+	SUBCASE("destroyed")
+	{
+		{
+			lib::log_queue queue([&messages](const lib::log_message &message)
+			{
+				messages.push_back(message);
+			});
+
+			for (auto i = 0; i < 100; i++)
+			{
+				queue.push(lib::log_type::information, std::to_string(i));
+			}
+		}
+
+		CHECK_EQ(messages.size(), 100);
+	}
+
+	SUBCASE("threads")
+	{
+		constexpr int thread_count = 4;
+		constexpr int message_count = 1000;
+
+		lib::log_queue queue([&messages](const lib::log_message &message)
+		{
+			messages.push_back(message);
+		});
+
+		std::vector<std::thread> threads;
+		for (auto i = 0; i < thread_count; i++)
+		{
+			threads.emplace_back([&queue, i]()
+			{
+				for (auto j = 0; j < message_count; j++)
+				{
+					queue.push(lib::log_type::information,
+						lib::fmt::format("{} {}", i, j));
+				}
+			});
+		}
+
+		for (auto &thread: threads)
+		{
+			thread.join();
+		}
+		queue.flush();
+
+		REQUIRE_EQ(messages.size(), thread_count * message_count);
+
+		// Messages from each thread are written in the order they were added
+		std::map<std::string, int> next;
+		for (const auto &message: messages)
+		{
+			const auto text = message.get_message();
+			const auto separator = text.find(' ');
+			auto &expected = next[text.substr(0, separator)];
+			CHECK_EQ(std::stoi(text.substr(separator + 1)), expected);
+			expected++;
+		}
+		CHECK_EQ(next.size(), thread_count);
+	}
+}
@@ -0,0 +1,138 @@
+#include "thirdparty/doctest.h"
+#include "lib/logstore.hpp"
+
+#include <fstream>
+
+TEST_CASE("log_store")
+{
+	lib::log_store store(3);
+
+	auto add = [&store](lib::log_type type, int count)
+	{
+		for (auto i = 0; i < count; i++)
+		{
+			store.add(lib::log_message(type, std::to_string(i)));
+		}
+	};
+
+	auto text = [](const std::vector<lib::log_message> &messages) -> std::vector<std::string>
+	{
+		std::vector<std::string> result;
+		for (const auto &message: messages)
+		{
+			result.push_back(message.get_message());
+		}
+		return result;
+	};
+
+	SUBCASE("retention per type")
+	{
+		add(lib::log_type::error, 1);
+		add(lib::log_type::verbose, 5);
+
+		CHECK_EQ(store.size(), 4);
+		CHECK_EQ(text(store.get_messages()), std::vector<std::string>{
+			"0", "2", "3", "4",
+		});
+		CHECK_EQ(store.get_messages().front().get_log_type(), lib::log_type::error);
+	}
+
+	SUBCASE("read incrementally")
+	{
+		std::vector<lib::log_message> messages;
+
+		add(lib::log_type::information, 2);
+		auto cursor = store.read(0, messages);
+		CHECK_EQ(messages.size(), 2);
+
+		cursor = store.read(cursor, messages);
+		CHECK_EQ(messages.size(), 2);
+
+		add(lib::log_type::warning, 1);
+		add(lib::log_type::information, 1);
+		store.read(cursor, messages);
+		CHECK_EQ(text(messages), std::vector<std::string>{
+			"0", "1", "0", "0",
+		});
+		CHECK_EQ(messages.at(2).get_log_type(), lib::log_type::warning);
+	}
+
+	SUBCASE("read removed")
+	{
+		std::vector<lib::log_store::entry> entries;
+
+		add(lib::log_type::error, 1);
+		add(lib::log_type::verbose, 2);
+		const auto first = store.read(0, entries);
+		REQUIRE_EQ(entries.size(), 3);
+
+		// Only the oldest verbose message is removed
+		add(lib::log_type::verbose, 2);
+		const auto second = store.read(first.cursor, entries);
+		CHECK_EQ(entries.size(), 5);
+		CHECK(second.is_kept(entries.at(0).sequence, lib::log_type::error));
+		CHECK_FALSE(second.is_kept(entries.at(1).sequence, lib::log_type::verbose));
+		CHECK(second.is_kept(entries.at(2).sequence, lib::log_type::verbose));
+
+		store.clear();
+		const auto third = store.read(second.cursor, entries);
+		CHECK_FALSE(third.is_kept(entries.at(0).sequence, lib::log_type::error));
+		CHECK_FALSE(third.is_kept(entries.at(4).sequence, lib::log_type::verbose));
+	}
+
+	SUBCASE("set_capacity")
+	{
+		add(lib::log_type::information, 3);
+		store.set_capacity(lib::log_type::information, 1);
+		CHECK_EQ(text(store.get_messages()), std::vector<std::string>{
+			"2",
+		});
+
+		store.set_capacity(lib::log_type::information, 2);
+		add(lib::log_type::information, 2);
+		CHECK_EQ(text(store.get_messages()), std::vector<std::string>{
+			"0", "1",
+		});
+
+		store.clear();
+		CHECK_EQ(store.size(), 0);
+	}
+
+	SUBCASE("spill")
+	{
+		const auto path = ghc::filesystem::temp_directory_path()
+			/ "spotify-qt-log-store" / "spotify-qt.log";
+		ghc::filesystem::remove_all(path.parent_path());
+
+		// Each line is 21 bytes, so each file fits two lines
+		store.set_spill(path, 50, 2);
+		add(lib::log_type::information, 9);
+
+		auto lines = [](const ghc::filesystem::path &file) -> std::vector<std::string>
+		{
+			std::vector<std::string> result;
+			std::ifstream stream(file.string());
+			std::string line;
+			while (std::getline(stream, line))
+			{
+				result.push_back(line.substr(line.rfind(' ') + 1));
+			}
+			return result;
+		};
+
+		CHECK_EQ(text(store.get_messages()), std::vector<std::string>{
+			"6", "7", "8",
+		});
+
+		CHECK_EQ(lines(path), std::vector<std::string>{
+			"4", "5",
+		});
+		CHECK_EQ(lines(path.string() + ".1"), std::vector<std::string>{
+			"2", "3",
+		});
+		CHECK_FALSE(ghc::filesystem::exists(path.string() + ".2"));
+
+		store.set_spill(ghc::filesystem::path(), 0, 0);
+		ghc::filesystem::remove_all(path.parent_path());
+	}
+}
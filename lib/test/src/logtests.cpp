@@ -58,4 +58,46 @@ TEST_CASE("log")
 		lib::log::debug("hello {}", "world");
 		verify_messages();
 	}
+
+	SUBCASE("set_enabled")
+	{
+		init_log();
+
+		lib::log::set_enabled(lib::log_type::warning, false);
+		CHECK_FALSE(lib::log::is_enabled(lib::log_type::warning));
+		CHECK(lib::log::is_enabled(lib::log_type::error));
+
+		lib::log::warn("hello world");
+		lib::log::warn("hello {}", "world");
+		CHECK_EQ(lib::log::get_messages().size(), 0);
+
+		lib::log::set_enabled(lib::log_type::warning, true);
+		lib::log::warn("hello world");
+		lib::log::warn("hello {}", "world");
+		verify_messages();
+	}
+
+	SUBCASE("threads")
+	{
+		init_log();
+
+		std::vector<std::thread> threads;
+		for (auto i = 0; i < 4; i++)
+		{
+			threads.emplace_back([]()
+			{
+				for (auto j = 0; j < 100; j++)
+				{
+					lib::log::info("hello {}", j);
+				}
+			});
+		}
+
+		for (auto &thread: threads)
+		{
+			thread.join();
+		}
+
+		CHECK_EQ(lib::log::get_messages().size(), 400);
+	}
 }
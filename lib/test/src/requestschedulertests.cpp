@@ -0,0 +1,142 @@
+#include "thirdparty/doctest.h"
+#include "lib/requestscheduler.hpp"
+
+#include <deque>
+
+TEST_CASE("request_scheduler")
+{
+	std::deque<std::pair<std::string, std::function<void()>>> sent;
+
+	auto sender = [&sent](const std::string &name) -> lib::request_scheduler::starter
+	{
+		return [&sent, name](const std::function<void()> &finished)
+		{
+			sent.emplace_back(name, finished);
+		};
+	};
+
+	SUBCASE("priority")
+	{
+		CHECK_EQ(lib::request_scheduler::priority("https://api.spotify.com/v1/me/player/play"),
+			lib::request_priority::playback);
+		CHECK_EQ(lib::request_scheduler::priority("https://api.spotify.com/v1/playlists/id"),
+			lib::request_priority::metadata);
+		CHECK_EQ(lib::request_scheduler::priority("https://i.scdn.co/image/id"),
+			lib::request_priority::image);
+		CHECK_EQ(lib::request_scheduler::priority("invalid"),
+			lib::request_priority::metadata);
+	}
+
+	SUBCASE("limits requests per host")
+	{
+		lib::request_scheduler scheduler(2);
+
+		for (const auto &name: {"a", "b", "c"})
+		{
+			scheduler.schedule("https://api.spotify.com/v1/me", lib::request_priority::metadata,
+				sender(name));
+		}
+		scheduler.schedule("https://i.scdn.co/image/id", lib::request_priority::image,
+			sender("image"));
+
+		REQUIRE_EQ(sent.size(), 3);
+		CHECK_EQ(scheduler.active("api.spotify.com"), 2);
+		CHECK_EQ(scheduler.queued("api.spotify.com"), 1);
+		CHECK_EQ(scheduler.active("i.scdn.co"), 1);
+
+		sent.front().second();
+		REQUIRE_EQ(sent.size(), 4);
+		CHECK_EQ(sent.back().first, "c");
+		CHECK_EQ(scheduler.active("api.spotify.com"), 2);
+		CHECK_EQ(scheduler.queued("api.spotify.com"), 0);
+	}
+
+	SUBCASE("multiplexed")
+	{
+		lib::request_scheduler scheduler(1);
+		const std::string url = "https://api.spotify.com/v1/me";
+
+		for (const auto &name: {"a", "b", "c"})
+		{
+			scheduler.schedule(url, lib::request_priority::metadata, sender(name));
+		}
+		REQUIRE_EQ(sent.size(), 1);
+
+		// Queued requests are sent once allowed
+		scheduler.set_multiplexed(url);
+		CHECK_EQ(sent.size(), 3);
+		CHECK_EQ(scheduler.active("api.spotify.com"), 3);
+		CHECK_EQ(scheduler.queued("api.spotify.com"), 0);
+
+		// Other hosts are still limited
+		const std::string image_url = "https://i.scdn.co/image/id";
+		scheduler.schedule(image_url, lib::request_priority::image, sender("image1"));
+		scheduler.schedule(image_url, lib::request_priority::image, sender("image2"));
+		CHECK_EQ(scheduler.queued("i.scdn.co"), 1);
+	}
+
+	SUBCASE("sends higher priority first")
+	{
+		lib::request_scheduler scheduler(1);
+		const std::string url = "https://api.spotify.com/v1/me/player";
+
+		scheduler.schedule(url, lib::request_priority::metadata, sender("first"));
+		scheduler.schedule(url, lib::request_priority::image, sender("image"));
+		scheduler.schedule(url, lib::request_priority::metadata, sender("metadata"));
+		scheduler.schedule(url, lib::request_priority::playback, sender("playback"));
+
+		std::vector<std::string> order;
+		while (!sent.empty())
+		{
+			auto request = sent.front();
+			sent.pop_front();
+			order.push_back(request.first);
+			request.second();
+		}
+
+		CHECK_EQ(order, std::vector<std::string>{
+			"first", "playback", "metadata", "image",
+		});
+		CHECK_EQ(scheduler.active("api.spotify.com"), 0);
+	}
+
+	SUBCASE("finishing twice")
+	{
+		lib::request_scheduler scheduler(1);
+		const std::string url = "https://api.spotify.com/v1/me";
+
+		scheduler.schedule(url, lib::request_priority::metadata, sender("a"));
+		scheduler.schedule(url, lib::request_priority::metadata, sender("b"));
+		scheduler.schedule(url, lib::request_priority::metadata, sender("c"));
+
+		const auto finished = sent.front().second;
+		finished();
+		finished();
+
+		CHECK_EQ(sent.size(), 2);
+		CHECK_EQ(scheduler.active("api.spotify.com"), 1);
+		CHECK_EQ(scheduler.latency(lib::request_priority::metadata).count(), 1);
+	}
+
+	SUBCASE("latency")
+	{
+		constexpr size_t bucket_count = lib::latency_histogram::bucket_count;
+
+		lib::latency_histogram histogram;
+		histogram.add(lib::latency_histogram::ms(10));
+		histogram.add(lib::latency_histogram::ms(120));
+		histogram.add(lib::latency_histogram::ms(130));
+		histogram.add(lib::latency_histogram::ms(5000));
+
+		CHECK_EQ(histogram.count(), 4);
+		CHECK_EQ(histogram.mean().count(), 1315);
+		CHECK_EQ(histogram.max().count(), 5000);
+		CHECK_EQ(histogram.bucket(0), 1);
+		CHECK_EQ(histogram.bucket(2), 2);
+		CHECK_EQ(histogram.bucket(bucket_count - 1), 1);
+
+		const nlohmann::json json = histogram;
+		CHECK_EQ(json.at("buckets").size(), bucket_count);
+		CHECK_EQ(json.at("buckets").back().at("range").get<std::string>(), ">= 2500 ms");
+	}
+}
@@ -0,0 +1,97 @@
+#include "thirdparty/doctest.h"
+#include "lib/search/trackindex.hpp"
+#include "lib/fmt.hpp"
+
+TEST_CASE("track_index")
+{
+	auto make_track = [](const std::string &id, const std::string &name,
+		const std::string &album, const std::string &artist) -> lib::spt::track
+	{
+		lib::spt::track track;
+		track.id = id;
+		track.name = name;
+		track.album = lib::spt::entity(lib::fmt::format("{}-album", id), album);
+		track.artists.emplace_back(lib::fmt::format("{}-artist", id), artist);
+		return track;
+	};
+
+	const std::vector<lib::spt::track> liked{
+		make_track("1", "Here Comes the Sun", "Abbey Road", "The Beatles"),
+		make_track("2", "Bohemian Rhapsody", "A Night at the Opera", "Queen"),
+	};
+
+	const std::vector<lib::spt::track> playlist{
+		make_track("2", "Bohemian Rhapsody", "A Night at the Opera", "Queen"),
+		make_track("3", "Don't Stop Me Now", "Jazz", "Queen"),
+	};
+
+	lib::track_index index;
+	CHECK(index.set_tracks("liked", liked));
+	CHECK(index.set_tracks("playlist", playlist));
+
+	auto ids = [&index](const std::string &query) -> std::vector<std::string>
+	{
+		std::vector<std::string> results;
+		for (const auto &track: index.search(query))
+		{
+			results.push_back(track.id);
+		}
+		return results;
+	};
+
+	SUBCASE("tokenize")
+	{
+		const std::vector<std::string> expected{
+			"don", "t", "stop", "me", "now",
+		};
+		CHECK_EQ(lib::track_index::tokenize(" Don't STOP me-now!"), expected);
+	}
+
+	SUBCASE("search")
+	{
+		CHECK_EQ(index.size(), 3);
+		CHECK(ids("").empty());
+
+		CHECK_EQ(ids("queen"), std::vector<std::string>{"2", "3"});
+		CHECK_EQ(ids("QUE"), std::vector<std::string>{"2", "3"});
+		CHECK_EQ(ids("queen jazz"), std::vector<std::string>{"3"});
+		CHECK_EQ(ids("beatles sun"), std::vector<std::string>{"1"});
+		CHECK(ids("queen sun").empty());
+
+		// Part of word
+		CHECK_EQ(ids("eatle"), std::vector<std::string>{"1"});
+		CHECK_EQ(ids("hapsod"), std::vector<std::string>{"2"});
+		CHECK(ids("ea").empty());
+	}
+
+	SUBCASE("set_tracks")
+	{
+		CHECK_FALSE(index.set_tracks("liked", liked));
+
+		// Removed from one source, but still in another
+		CHECK(index.set_tracks("liked", {liked.front()}));
+		CHECK_EQ(ids("queen"), std::vector<std::string>{"2", "3"});
+
+		index.remove_source("playlist");
+		CHECK(ids("queen").empty());
+		CHECK_EQ(index.size(), 1);
+		CHECK_FALSE(index.has_source("playlist"));
+
+		// Renamed
+		auto renamed = liked.front();
+		renamed.name = "Something";
+		index.set_tracks("liked", {renamed});
+		CHECK(ids("sun").empty());
+		CHECK_EQ(ids("something"), std::vector<std::string>{"1"});
+	}
+
+	SUBCASE("search order")
+	{
+		// Document of removed track is reused for the next added one
+		index.remove_source("liked");
+		index.set_tracks("other", {
+			make_track("4", "Killer Queen", "Sheer Heart Attack", "Queen"),
+		});
+		CHECK_EQ(ids("queen"), std::vector<std::string>{"2", "3", "4"});
+	}
+}
@@ -1,36 +1,11 @@
 #include "thirdparty/doctest.h"
 #include "lib/settings.hpp"
 
-#include "lib/paths/paths.hpp"
-#include "thirdparty/filesystem.hpp"
-
-class test_paths: public lib::paths
-{
-public:
-	test_paths()
-	{
-		lib::log::set_log_to_stdout(false);
-	}
-
-	~test_paths()
-	{
-		ghc::filesystem::remove(config_file());
-	}
-
-	auto config_file() const -> ghc::filesystem::path override
-	{
-		return ghc::filesystem::temp_directory_path() / "spotify-qt.json";
-	}
-
-	auto cache() const -> ghc::filesystem::path override
-	{
-		return ghc::filesystem::temp_directory_path() / "cache";
-	}
-};
+#include "testpaths.hpp"
 
 TEST_CASE("settings")
 {
-	test_paths paths;
+	test_paths paths("settings");
 
 	auto read_settings = [&paths]() -> nlohmann::json
 	{
@@ -45,6 +20,7 @@ TEST_CASE("settings")
 	{
 		lib::settings settings(paths);
 		settings.save();
+		settings.flush();
 
 		return read_settings();
 	};
@@ -67,9 +43,25 @@ TEST_CASE("settings")
 		lib::settings settings(paths);
 		settings.qt();
 		settings.save();
+		settings.flush();
 
 		json = read_settings();
 		CHECK(json.contains("Qt"));
 		CHECK(json.at("Qt").is_object());
 	}
+
+	SUBCASE("save is delayed")
+	{
+		ghc::filesystem::remove(paths.config_file());
+
+		lib::settings settings(paths);
+		settings.general.last_volume = 1;
+		settings.save();
+		settings.general.last_volume = 2;
+		settings.save();
+		CHECK_FALSE(ghc::filesystem::exists(paths.config_file()));
+
+		settings.flush();
+		CHECK_EQ(read_settings().at("General").at("last_volume").get<int>(), 2);
+	}
 }
@@ -0,0 +1,179 @@
+#include "thirdparty/doctest.h"
+#include "lib/spotify/paginator.hpp"
+
+#include <deque>
+
+TEST_CASE("paginator")
+{
+	constexpr size_t total = 230;
+	constexpr size_t limit = 50;
+	const std::string base_url = "https://api.spotify.com/v1/me/tracks";
+
+	auto page = [&](size_t offset) -> nlohmann::json
+	{
+		auto items = nlohmann::json::array();
+		for (auto i = offset; i < offset + limit && i < total; i++)
+		{
+			items.push_back(i);
+		}
+
+		return {
+			{"items", items},
+			{"limit", limit},
+			{"offset", offset},
+			{"total", total},
+			{"next", offset + limit < total
+				? nlohmann::json(lib::fmt::format("{}?limit={}&offset={}",
+					base_url, limit, offset + limit))
+				: nlohmann::json()},
+		};
+	};
+
+	auto offset_of = [](const std::string &url) -> size_t
+	{
+		return std::stoul(lib::uri(url).get_search_params().at("offset"));
+	};
+
+	auto verify = [&](const nlohmann::json &items)
+	{
+		REQUIRE_EQ(items.size(), total);
+		for (size_t i = 0; i < total; i++)
+		{
+			CHECK_EQ(items.at(i).get<size_t>(), i);
+		}
+	};
+
+	SUBCASE("page_url")
+	{
+		CHECK_EQ(lib::spt::paginator::page_url(lib::fmt::format("{}?limit=50&offset=50",
+			base_url), 100), lib::fmt::format("{}?limit=50&offset=100", base_url));
+
+		CHECK(lib::spt::paginator::page_url(lib::fmt::format("{}?limit=50&after=abc",
+			base_url), 100).empty());
+
+		CHECK(lib::spt::paginator::page_url("me/tracks?offset=50", 100).empty());
+	}
+
+	SUBCASE("load")
+	{
+		std::vector<std::string> urls;
+		nlohmann::json result;
+
+		lib::spt::paginator::load(lib::fmt::format("{}?limit={}&offset=0", base_url, limit),
+			std::string(), 4,
+			[&](const std::string &url, lib::callback<nlohmann::json> &callback)
+			{
+				urls.push_back(url);
+				callback(page(offset_of(url)));
+			}, [&result](const nlohmann::json &items)
+			{
+				result = items;
+			});
+
+		CHECK_EQ(urls.size(), 5);
+		verify(result);
+	}
+
+	SUBCASE("out of order")
+	{
+		std::deque<std::pair<std::string, std::function<void(const nlohmann::json &)>>> queue;
+		size_t max_in_flight = 0;
+		auto calls = 0;
+		nlohmann::json result;
+
+		lib::spt::paginator::load(lib::fmt::format("{}?limit={}&offset=0", base_url, limit),
+			"tracks", 2,
+			[&](const std::string &url, lib::callback<nlohmann::json> &callback)
+			{
+				queue.emplace_back(url, callback);
+				max_in_flight = std::max(max_in_flight, queue.size());
+			}, [&](const nlohmann::json &items)
+			{
+				calls++;
+				result = items;
+			});
+
+		while (!queue.empty())
+		{
+			// Reply to the most recent request first
+			auto request = queue.back();
+			queue.pop_back();
+			request.second({
+				{"tracks", page(offset_of(request.first))},
+			});
+		}
+
+		CHECK_EQ(calls, 1);
+		CHECK_EQ(max_in_flight, 2);
+		verify(result);
+	}
+
+	SUBCASE("stream")
+	{
+		std::deque<std::pair<std::string, std::function<void(const nlohmann::json &)>>> queue;
+		auto items = nlohmann::json::array();
+		auto last_pages = 0;
+
+		lib::spt::paginator::stream(lib::fmt::format("{}?limit={}&offset=0", base_url, limit),
+			std::string(), 3,
+			[&](const std::string &url, lib::callback<nlohmann::json> &callback)
+			{
+				queue.emplace_back(url, callback);
+			}, [&](const nlohmann::json &page, bool is_last)
+			{
+				items.insert(items.end(), page.begin(), page.end());
+				if (is_last)
+				{
+					last_pages++;
+				}
+			});
+
+		// First page is returned as soon as it's loaded
+		auto first = queue.front();
+		queue.pop_front();
+		first.second(page(offset_of(first.first)));
+		CHECK_EQ(items.size(), limit);
+
+		// Later pages are held back until all pages before them are returned
+		auto third = queue.back();
+		queue.pop_back();
+		third.second(page(offset_of(third.first)));
+		CHECK_EQ(items.size(), limit);
+
+		while (!queue.empty())
+		{
+			auto request = queue.front();
+			queue.pop_front();
+			request.second(page(offset_of(request.first)));
+		}
+
+		CHECK_EQ(last_pages, 1);
+		verify(items);
+	}
+
+	SUBCASE("cursor")
+	{
+		auto requests = 0;
+		nlohmann::json result;
+
+		lib::spt::paginator::load(lib::fmt::format("{}?after=0", base_url),
+			std::string(), 4,
+			[&](const std::string &url, lib::callback<nlohmann::json> &callback)
+			{
+				requests++;
+				auto after = std::stoul(lib::uri(url).get_search_params().at("after"));
+				auto json = page(after);
+				if (json.at("next").is_string())
+				{
+					json["next"] = lib::fmt::format("{}?after={}", base_url, after + limit);
+				}
+				callback(json);
+			}, [&result](const nlohmann::json &items)
+			{
+				result = items;
+			});
+
+		CHECK_EQ(requests, 5);
+		verify(result);
+	}
+}
@@ -0,0 +1,85 @@
+#include "thirdparty/doctest.h"
+#include "lib/spotify/playbackstate.hpp"
+
+TEST_CASE("spt::playback_state")
+{
+	using ms = lib::spt::playback_state::ms;
+	const auto now = lib::spt::playback_state::clock::now();
+
+	lib::spt::playback playback;
+	playback.item.id = "track";
+	playback.item.name = "Track";
+	playback.item.duration = 180000;
+	playback.progress_ms = 1000;
+	playback.is_playing = true;
+
+	lib::spt::playback_state state;
+
+	SUBCASE("update")
+	{
+		auto changes = state.update(playback);
+		CHECK(changes.track);
+		CHECK(changes.playing);
+		CHECK(changes.volume);
+
+		changes = state.update(playback);
+		CHECK_FALSE(changes.any());
+
+		playback.progress_ms += 1000;
+		changes = state.update(playback);
+		CHECK(changes.progress);
+		CHECK_FALSE(changes.track);
+		CHECK_FALSE(changes.playing);
+
+		playback.shuffle = true;
+		playback.repeat = lib::repeat_state::context;
+		changes = state.update(playback);
+		CHECK(changes.shuffle);
+		CHECK(changes.repeat);
+		CHECK_FALSE(changes.progress);
+
+		playback.item.id = "other";
+		changes = state.update(playback);
+		CHECK(changes.track);
+		CHECK(changes.progress);
+		CHECK_EQ(state.get().item.id, "other");
+	}
+
+	SUBCASE("progress_ms")
+	{
+		state.update(playback, now);
+		CHECK_EQ(state.progress_ms(now), 1000);
+		CHECK_EQ(state.progress_ms(now + ms(2500)), 3500);
+		CHECK_EQ(state.progress_ms(now + std::chrono::hours(1)), playback.item.duration);
+		CHECK_EQ(state.progress_ms(now - ms(500)), 1000);
+
+		playback.is_playing = false;
+		state.update(playback, now);
+		CHECK_EQ(state.progress_ms(now + ms(2500)), 1000);
+	}
+
+	SUBCASE("poll_interval")
+	{
+		const ms interval(3000);
+		state.update(playback, now);
+
+		CHECK_EQ(state.poll_interval(interval, true, now), interval);
+		CHECK_EQ(state.poll_interval(interval, false, now), interval * 4);
+		CHECK_EQ(state.poll_interval(ms(0), true, now), ms(1000));
+
+		// Near end of track
+		playback.progress_ms = playback.item.duration - 3000;
+		state.update(playback, now);
+		CHECK_EQ(state.poll_interval(interval, true, now), interval);
+		CHECK_EQ(state.poll_interval(interval, true, now + ms(2000)), ms(1500));
+		CHECK_EQ(state.poll_interval(interval, false, now + ms(2000)), ms(1500));
+		CHECK_EQ(state.poll_interval(interval, true, now + ms(5000)), ms(1000));
+
+		// Paused
+		playback.is_playing = false;
+		state.update(playback, now);
+		CHECK_EQ(state.poll_interval(interval, true, now), interval * 4);
+		CHECK_EQ(state.poll_interval(interval, false, now), ms(48000));
+		CHECK_EQ(state.poll_interval(ms(10000), false, now), ms(60000));
+	}
+}
@@ -0,0 +1,167 @@
+#include "thirdparty/doctest.h"
+#include "lib/spotify/playlistsync.hpp"
+
+TEST_CASE("spt::playlist_sync")
+{
+	constexpr size_t page_size = 2;
+
+	auto track = [](const std::string &id, const std::string &name) -> lib::spt::track
+	{
+		lib::spt::track result;
+		result.id = id;
+		result.name = name;
+		result.added_at = "2023-01-01T00:00:00Z";
+		return result;
+	};
+
+	auto item = [](const lib::spt::track &track) -> lib::spt::track
+	{
+		lib::spt::track result;
+		result.id = track.id;
+		result.name = track.name;
+		result.added_at = track.added_at;
+		return result;
+	};
+
+	auto names = [](const std::vector<lib::spt::track> &tracks) -> std::vector<std::string>
+	{
+		std::vector<std::string> result;
+		for (const auto &track: tracks)
+		{
+			result.push_back(track.name);
+		}
+		return result;
+	};
+
+	const std::vector<lib::spt::track> cached{
+		track("a", "A"),
+		track("b", "B"),
+		track("c", "C"),
+		track("d", "D"),
+		track("e", "E"),
+	};
+
+	SUBCASE("is_up_to_date")
+	{
+		lib::spt::playlist saved;
+		saved.id = "playlist";
+		saved.snapshot = "snapshot";
+		saved.tracks = cached;
+
+		auto latest = saved;
+		latest.tracks.clear();
+		latest.tracks_total = static_cast<int>(cached.size());
+		CHECK(latest.is_up_to_date(saved));
+
+		latest.tracks_total++;
+		CHECK_FALSE(latest.is_up_to_date(saved));
+
+		latest.tracks_total = -1;
+		latest.snapshot = "other";
+		CHECK_FALSE(latest.is_up_to_date(saved));
+
+		CHECK_FALSE(latest.is_up_to_date(lib::spt::playlist()));
+	}
+
+	SUBCASE("unchanged")
+	{
+		std::vector<lib::spt::track> items;
+		for (const auto &cached_track: cached)
+		{
+			items.push_back(item(cached_track));
+		}
+
+		CHECK(lib::spt::playlist_sync::changed_pages(cached, items, page_size).empty());
+
+		std::vector<lib::spt::track> tracks;
+		REQUIRE(lib::spt::playlist_sync::merge(cached, items, {}, page_size, tracks));
+		CHECK_EQ(names(tracks), names(cached));
+	}
+
+	SUBCASE("reordered and removed")
+	{
+		const std::vector<lib::spt::track> items{
+			item(cached.at(4)),
+			item(cached.at(0)),
+			item(cached.at(2)),
+		};
+
+		CHECK(lib::spt::playlist_sync::changed_pages(cached, items, page_size).empty());
+
+		std::vector<lib::spt::track> tracks;
+		REQUIRE(lib::spt::playlist_sync::merge(cached, items, {}, page_size, tracks));
+		CHECK_EQ(names(tracks), std::vector<std::string>{
+			"E", "A", "C",
+		});
+	}
+
+	SUBCASE("added")
+	{
+		const auto added = track("f", "F");
+		auto duplicate = track("a", "A2");
+		duplicate.added_at = "2024-01-01T00:00:00Z";
+
+		const std::vector<lib::spt::track> items{
+			item(cached.at(0)),
+			item(cached.at(1)),
+			item(cached.at(2)),
+			item(added),
+			item(cached.at(3)),
+			item(duplicate),
+		};
+
+		const auto pages = lib::spt::playlist_sync::changed_pages(cached, items, page_size);
+		CHECK_EQ(pages, std::vector<size_t>{
+			1, 2,
+		});
+
+		std::vector<lib::spt::track> tracks;
+		CHECK_FALSE(lib::spt::playlist_sync::merge(cached, items, {}, page_size, tracks));
+
+		const std::map<size_t, std::vector<lib::spt::track>> downloaded{
+			{1, {track("c", "C"), added}},
+			{2, {track("d", "D"), duplicate}},
+		};
+
+		REQUIRE(lib::spt::playlist_sync::merge(cached, items, downloaded, page_size, tracks));
+		CHECK_EQ(names(tracks), std::vector<std::string>{
+			"A", "B", "C", "F", "D", "A2",
+		});
+	}
+
+	SUBCASE("local files")
+	{
+		const auto local = track(std::string(), "Local");
+		auto with_local = cached;
+		with_local.push_back(local);
+
+		const std::vector<lib::spt::track> items{
+			item(cached.at(0)),
+			item(cached.at(1)),
+			item(local),
+		};
+
+		CHECK(lib::spt::playlist_sync::changed_pages(with_local, items, page_size).empty());
+
+		std::vector<lib::spt::track> tracks;
+		REQUIRE(lib::spt::playlist_sync::merge(with_local, items, {}, page_size, tracks));
+		CHECK_EQ(names(tracks), std::vector<std::string>{
+			"A", "B", "Local",
+		});
+	}
+
+	SUBCASE("changed while loading")
+	{
+		const std::vector<lib::spt::track> items{
+			item(cached.at(0)),
+			item(track("f", "F")),
+		};
+
+		const std::map<size_t, std::vector<lib::spt::track>> downloaded{
+			{0, {track("a", "A"), track("g", "G")}},
+		};
+
+		std::vector<lib::spt::track> tracks;
+		CHECK_FALSE(lib::spt::playlist_sync::merge(cached, items, downloaded, page_size, tracks));
+	}
+}
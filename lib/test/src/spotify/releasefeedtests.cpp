@@ -0,0 +1,68 @@
+#include "thirdparty/doctest.h"
+#include "lib/spotify/releasefeed.hpp"
+
+#include <deque>
+
+TEST_CASE("release_feed")
+{
+	lib::log::set_log_to_stdout(false);
+
+	lib::spt::playlist playlist;
+	playlist.id = "playlist";
+	playlist.tracks.resize(2);
+	playlist.tracks.at(0).artists.emplace_back("artist1", "Artist 1");
+	playlist.tracks.at(1).artists.emplace_back("artist2", "Artist 2");
+
+	lib::playlist_index index;
+	index.update(playlist);
+
+	std::vector<lib::spt::album> releases(4);
+	for (size_t i = 0; i < releases.size(); i++)
+	{
+		auto &album = releases.at(i);
+		album.id = lib::fmt::format("album{}", i);
+		album.artist = lib::fmt::format("Artist {}", i);
+		album.release_date = lib::fmt::format("2021-01-0{}", i + 1);
+	}
+
+	using request = std::pair<lib::spt::album,
+		std::function<void(const std::vector<lib::spt::track> &)>>;
+
+	std::deque<request> queue;
+	size_t max_in_flight = 0;
+	auto calls = 0;
+	std::vector<lib::spt::track> result;
+
+	lib::spt::release_feed::load(releases, index, 1,
+		[&](const lib::spt::album &album,
+			lib::callback<std::vector<lib::spt::track>> &callback)
+		{
+			queue.emplace_back(album, callback);
+			max_in_flight = std::max(max_in_flight, queue.size());
+		}, [&](const std::vector<lib::spt::track> &tracks)
+		{
+			calls++;
+			result = tracks;
+		});
+
+	while (!queue.empty())
+	{
+		auto item = queue.front();
+		queue.pop_front();
+
+		std::vector<lib::spt::track> tracks(2);
+		tracks.at(0).id = lib::fmt::format("{}-1", item.first.id);
+		tracks.at(1).id = lib::fmt::format("{}-2", item.first.id);
+		item.second(tracks);
+	}
+
+	// Only albums from artists in playlists, newest first
+	CHECK_EQ(calls, 1);
+	CHECK_EQ(max_in_flight, 1);
+	REQUIRE_EQ(result.size(), 4);
+	CHECK_EQ(result.at(0).id, "album2-1");
+	CHECK_EQ(result.at(0).added_at, "2021-01-03");
+	CHECK_EQ(result.at(1).id, "album2-2");
+	CHECK_EQ(result.at(2).id, "album1-1");
+	CHECK_EQ(result.at(3).added_at, "2021-01-02");
+}
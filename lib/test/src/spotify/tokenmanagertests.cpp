@@ -0,0 +1,141 @@
+#include "thirdparty/doctest.h"
+#include "lib/spotify/tokenmanager.hpp"
+
+#include "testpaths.hpp"
+
+#include <deque>
+
+/**
+ * HTTP client that only replies to POST requests when asked to
+ */
+class token_http_client: public lib::http_client
+{
+public:
+	mutable std::deque<std::function<void(const std::string &)>> queue;
+
+	void get(const std::string &/*url*/, const lib::headers &/*headers*/,
+		lib::callback<std::string> &/*callback*/) const override
+	{
+	}
+
+	void put(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &/*callback*/) const override
+	{
+	}
+
+	void post(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &callback) const override
+	{
+		queue.push_back(callback);
+	}
+
+	auto post(const std::string &/*url*/, const lib::headers &/*headers*/,
+		const std::string &/*post_data*/) const -> std::string override
+	{
+		return R"({"access_token": "sync"})";
+	}
+
+	void del(const std::string &/*url*/, const std::string &/*body*/,
+		const lib::headers &/*headers*/, lib::callback<std::string> &/*callback*/) const override
+	{
+	}
+
+	void reply(const std::string &data)
+	{
+		auto callback = queue.front();
+		queue.pop_front();
+		callback(data);
+	}
+};
+
+TEST_CASE("spt::token_manager")
+{
+	test_paths paths("token-manager");
+	lib::settings settings(paths);
+	token_http_client http_client;
+	lib::spt::token_manager tokens(settings, http_client);
+
+	settings.account.refresh_token = "refresh";
+	settings.account.access_token = "old";
+
+	std::vector<std::string> tokens_used;
+	auto request = [&tokens_used](const lib::headers &headers)
+	{
+		tokens_used.push_back(headers.at("Authorization"));
+	};
+
+	SUBCASE("valid")
+	{
+		settings.account.last_refresh = lib::date_time::seconds_since_epoch();
+		tokens.headers(request);
+
+		CHECK(http_client.queue.empty());
+		REQUIRE_EQ(tokens_used.size(), 1);
+		CHECK_EQ(tokens_used.front(), "Bearer old");
+	}
+
+	SUBCASE("refresh ahead")
+	{
+		// Expires in a minute
+		settings.account.last_refresh = lib::date_time::seconds_since_epoch() - 59 * 60;
+		tokens.headers(request);
+		tokens.headers(request);
+
+		// Not waiting for refresh, and only refreshed once
+		CHECK_EQ(tokens_used.size(), 2);
+		CHECK_EQ(http_client.queue.size(), 1);
+		CHECK(tokens.is_refreshing());
+
+		http_client.reply(R"({"access_token": "new"})");
+		CHECK_FALSE(tokens.is_refreshing());
+		CHECK_EQ(settings.account.access_token, "new");
+		CHECK_GT(tokens.expires_in(), 59 * 60);
+	}
+
+	SUBCASE("expired")
+	{
+		settings.account.last_refresh = 0;
+		tokens.headers(request);
+		tokens.headers(request);
+
+		// Waiting for refresh
+		CHECK(tokens_used.empty());
+		CHECK_EQ(http_client.queue.size(), 1);
+
+		http_client.reply(R"({"access_token": "new"})");
+		REQUIRE_EQ(tokens_used.size(), 2);
+		CHECK_EQ(tokens_used.at(0), "Bearer new");
+		CHECK_EQ(tokens_used.at(1), "Bearer new");
+	}
+
+	SUBCASE("failed")
+	{
+		settings.account.last_refresh = 0;
+		tokens.headers(request);
+
+		std::string error;
+		tokens.refresh([&error](const std::string &message)
+		{
+			error = message;
+		});
+
+		http_client.reply(R"({"error_description": "Invalid refresh token"})");
+		CHECK_EQ(error, "Invalid refresh token");
+
+		// Requests are still sent
+		REQUIRE_EQ(tokens_used.size(), 1);
+		CHECK_EQ(tokens_used.front(), "Bearer old");
+	}
+
+	SUBCASE("sync")
+	{
+		tokens.refresh();
+		CHECK_EQ(settings.account.access_token, "sync");
+	}
+
+	SUBCASE("no refresh token")
+	{
+		settings.account.refresh_token.clear();
+		CHECK_THROWS(tokens.refresh());
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "lib/log.hpp"
+#include "lib/paths/paths.hpp"
+#include "thirdparty/filesystem.hpp"
+
+/**
+ * Config file and cache in temporary directory, removed when destroyed
+ */
+class test_paths: public lib::paths
+{
+public:
+	/**
+	 * @param name Name of test, files are named spotify-qt-<name>
+	 */
+	explicit test_paths(const std::string &name)
+		: name(lib::fmt::format("spotify-qt-{}", name))
+	{
+		lib::log::set_log_to_stdout(false);
+	}
+
+	~test_paths()
+	{
+		ghc::filesystem::remove(config_file());
+		ghc::filesystem::remove_all(cache());
+	}
+
+	auto config_file() const -> ghc::filesystem::path override
+	{
+		return ghc::filesystem::temp_directory_path() / lib::fmt::format("{}.json", name);
+	}
+
+	auto cache() const -> ghc::filesystem::path override
+	{
+		return ghc::filesystem::temp_directory_path() / name;
+	}
+
+private:
+	std::string name;
+};
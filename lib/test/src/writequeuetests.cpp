@@ -0,0 +1,142 @@
+#include "thirdparty/doctest.h"
+#include "lib/writequeue.hpp"
+#include "lib/json.hpp"
+
+#include <future>
+
+TEST_CASE("write_queue")
+{
+	lib::log::set_log_to_stdout(false);
+
+	const auto directory = ghc::filesystem::temp_directory_path() / "spotify-qt-write-queue";
+	ghc::filesystem::remove_all(directory);
+	ghc::filesystem::create_directories(directory);
+
+	auto read = [](const ghc::filesystem::path &path) -> std::string
+	{
+		std::ifstream file(path.string(), std::ios::binary);
+		return {
+			std::istreambuf_iterator<char>(file),
+			std::istreambuf_iterator<char>(),
+		};
+	};
+
+	SUBCASE("write_atomic")
+	{
+		const auto path = directory / "file.txt";
+		CHECK(lib::write_queue::write_atomic(path, "first"));
+		CHECK(lib::write_queue::write_atomic(path, "second"));
+		CHECK_EQ(read(path), "second");
+
+		// Temporary file is replaced
+		auto temp_path = path;
+		temp_path += ".tmp";
+		CHECK_FALSE(ghc::filesystem::exists(temp_path));
+		CHECK(lib::write_queue::is_temp(temp_path));
+		CHECK_FALSE(lib::write_queue::is_temp(path));
+	}
+
+	SUBCASE("write")
+	{
+		lib::write_queue queue;
+
+		std::promise<void> started;
+		std::promise<void> resume;
+		auto resumed = resume.get_future().share();
+
+		// Keep background thread busy
+		queue.write(directory / "busy.txt", [&started, resumed]() -> std::string
+		{
+			started.set_value();
+			resumed.wait();
+			return "busy";
+		});
+		started.get_future().wait();
+
+		auto serialized = 0;
+		for (auto i = 0; i < 3; i++)
+		{
+			queue.write(directory / "file.txt", [&serialized, i]() -> std::string
+			{
+				serialized++;
+				return std::to_string(i);
+			});
+		}
+
+		resume.set_value();
+		queue.flush(directory / "file.txt");
+
+		// Only latest data is written
+		CHECK_EQ(serialized, 1);
+		CHECK_EQ(read(directory / "file.txt"), "2");
+		CHECK_EQ(read(directory / "busy.txt"), "busy");
+	}
+
+	SUBCASE("written")
+	{
+		lib::write_queue queue;
+
+		std::promise<void> written;
+		queue.write(directory / "file.txt", []() -> std::string
+		{
+			return "data";
+		}, [&written]()
+		{
+			written.set_value();
+		});
+
+		// Called once file is replaced
+		written.get_future().wait();
+		CHECK_EQ(read(directory / "file.txt"), "data");
+	}
+
+	SUBCASE("remove")
+	{
+		lib::write_queue queue;
+		CHECK(lib::write_queue::write_atomic(directory / "file.txt", "data"));
+
+		// Replaces pending write
+		queue.write(directory / "file.txt", []() -> std::string
+		{
+			return "new data";
+		});
+		queue.remove(directory / "file.txt");
+
+		queue.flush();
+		CHECK_FALSE(ghc::filesystem::exists(directory / "file.txt"));
+	}
+
+	SUBCASE("json")
+	{
+		const auto path = directory / "file.json";
+		lib::json::save(path, nlohmann::json{
+			{"key", "value"},
+		});
+
+		// Loaded from memory while saving
+		const auto json = lib::json::load(path);
+		CHECK_EQ(json.at("key").get<std::string>(), "value");
+
+		// Listed before being written
+		const auto files = lib::json::list(directory);
+		REQUIRE_EQ(files.size(), 1);
+		CHECK_EQ(files.front(), path);
+
+		lib::json::flush();
+		CHECK(ghc::filesystem::exists(path));
+		CHECK_EQ(lib::json::load(path).at("key").get<std::string>(), "value");
+
+		// No longer loaded from memory when removed
+		lib::json::save(path, nlohmann::json{
+			{"key", "new value"},
+		});
+		lib::json::remove(path);
+		CHECK(lib::json::load(path).is_null());
+		CHECK(lib::json::list(directory).empty());
+
+		lib::json::flush();
+		CHECK_FALSE(ghc::filesystem::exists(path));
+	}
+
+	ghc::filesystem::remove_all(directory);
+}
@@ -118,33 +118,15 @@ void List::Library::onClicked(QTreeWidgetItem *item, int /*column*/)
 		}
 		else if (item->text(0) == newReleases)
 		{
-			spotify.new_releases([this, mainWindow, callback]
+			spotify.new_releases([this, callback]
 				(const std::vector<lib::spt::album> &releases)
 			{
-				auto all = mainWindow->allArtists();
-				std::vector<lib::spt::track> tracks;
-
-				for (const auto &album: releases)
-				{
-					if (all.find(album.artist) != all.end())
+				lib::spt::release_feed::load(releases, cache.get_playlist_index(),
+					maxAlbumRequests, [this](const lib::spt::album &album,
+						lib::callback<std::vector<lib::spt::track>> &albumCallback)
 					{
-						spotify.album_tracks(album,
-							[album, callback](const std::vector<lib::spt::track> &results)
-							{
-								std::vector<lib::spt::track> tracks;
-								tracks.reserve(results.size());
-								for (const auto &result: results)
-								{
-									lib::spt::track track = result;
-									track.added_at = album.release_date;
-									tracks.push_back(track);
-								}
-								callback(tracks);
-							});
-						return;
-					}
-				}
-				callback(tracks);
+						spotify.album_tracks(album, albumCallback);
+					}, callback);
 			});
 		}
 	}
@@ -2,6 +2,7 @@
 
 #include "lib/spotify/api.hpp"
 #include "lib/cache.hpp"
+#include "lib/spotify/releasefeed.hpp"
 
 #include "util/tree.hpp"
 #include "listitem/library.hpp"
@@ -30,6 +31,11 @@ namespace List
 		static constexpr const char *topArtists = "Top Artists";
 		static constexpr const char *topTracks = "Top Tracks";
 
+		/**
+		 * Maximum number of new release albums to load at once
+		 */
+		static constexpr size_t maxAlbumRequests = 4;
+
 		void onClicked(QTreeWidgetItem *item, int column);
 		void onDoubleClicked(QTreeWidgetItem *item, int column);
 		void onExpanded(QTreeWidgetItem *item);
@@ -177,7 +177,6 @@ void List::Playlist::order(lib::playlist_order order)
 	}
 
 	QMap<QString, int> customOrder;
-	MainWindow *mainWindow;
 
 	switch (order)
 	{
@@ -199,30 +198,32 @@ void List::Playlist::order(lib::playlist_order order)
 			break;
 
 		case lib::playlist_order::recent:
+		{
 			// TODO: Currently sorts by when tracks where added, not when playlist was last played
-			mainWindow = MainWindow::find(parentWidget());
-			if (mainWindow == nullptr)
-			{
-				lib::log::error("Failed to order playlist: MainWindow not found");
-				break;
-			}
+			const auto &index = cache.get_playlist_index();
 
-			std::sort(items.begin(), items.end(), [this]
-				(QListWidgetItem *item1, QListWidgetItem *item2) -> bool
+			std::vector<std::pair<long long, QListWidgetItem *>> recent;
+			recent.reserve(items.size());
+			for (auto *item: items)
 			{
-				auto id1 = item1->data(static_cast<int>(DataRole::PlaylistId))
-					.toString().toStdString();
-				auto id2 = item2->data(static_cast<int>(DataRole::PlaylistId))
+				const auto playlistId = item->data(static_cast<int>(DataRole::PlaylistId))
 					.toString().toStdString();
+				recent.emplace_back(index.latest_added(playlistId), item);
+			}
 
-				auto track1 = this->cache.get_playlist(id1).tracks;
-				auto track2 = this->cache.get_playlist(id2).tracks;
+			std::stable_sort(recent.begin(), recent.end(),
+				[](const std::pair<long long, QListWidgetItem *> &item1,
+					const std::pair<long long, QListWidgetItem *> &item2) -> bool
+				{
+					return item1.first > item2.first;
+				});
 
-				return !track1.empty() && !track2.empty()
-					&& DateTime::parseIso(track1.at(latestTrack(track1)).added_at)
-						> DateTime::parseIso(track2.at(latestTrack(track2)).added_at);
-			});
+			for (auto i = 0; i < items.size(); i++)
+			{
+				items[i] = recent.at(i).second;
+			}
 			break;
+		}
 
 		case lib::playlist_order::custom:
 			auto index = 0;
@@ -255,41 +256,6 @@ void List::Playlist::order(lib::playlist_order order)
 	}
 }
 
-auto List::Playlist::latestTrack(const std::vector<lib::spt::track> &tracks) -> size_t
-{
-	size_t latest = 0;
-	for (size_t i = 0; i < tracks.size(); i++)
-	{
-		if (DateTime::parseIso(tracks[i].added_at)
-			> DateTime::parseIso(tracks[latest].added_at))
-		{
-			latest = i;
-		}
-	}
-	return latest;
-}
-
-auto List::Playlist::allArtists() -> std::unordered_set<std::string>
-{
-	std::unordered_set<std::string> artists;
-
-	for (auto i = 0; i < count(); i++)
-	{
-		auto playlistId = item(i)->data(static_cast<int>(DataRole::PlaylistId))
-			.toString().toStdString();
-
-		for (auto &track: cache.get_playlist(playlistId).tracks)
-		{
-			for (const auto &artist: track.artists)
-			{
-				artists.insert(artist.name);
-			}
-		}
-	}
-
-	return artists;
-}
-
 auto List::Playlist::at(int index) -> lib::spt::playlist
 {
 	auto *listItem = item(index);
@@ -21,8 +21,6 @@ namespace List
 		void refresh();
 		void order(lib::playlist_order item1);
 
-		auto allArtists() -> std::unordered_set<std::string>;
-
 		auto at(int index) -> lib::spt::playlist;
 		auto at(const std::string &playlistId) -> lib::spt::playlist;
 
@@ -38,7 +36,5 @@ namespace List
 		void clicked(QListWidgetItem *item);
 		void doubleClicked(QListWidgetItem *item);
 		void menu(const QPoint &pos);
-
-		static auto latestTrack(const std::vector<lib::spt::track> &tracks) -> size_t;
 	};
 }
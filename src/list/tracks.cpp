@@ -3,32 +3,24 @@
 
 List::Tracks::Tracks(lib::spt::api &spotify, lib::settings &settings, lib::cache &cache,
 	QWidget *parent)
-	: QTreeWidget(parent),
+	: QTreeView(parent),
 	settings(settings),
 	cache(cache),
 	spotify(spotify)
 {
-	constexpr int emptyPixmapSize = 64;
-	constexpr int columnCount = 5;
-
-	// Empty icon used as replacement for play icon
-	QPixmap emptyPixmap(emptyPixmapSize, emptyPixmapSize);
-	emptyPixmap.fill(Qt::transparent);
-	emptyIcon = QIcon(emptyPixmap);
+	trackModel = new TrackListModel(settings, this);
+	proxyModel = new TrackListProxyModel(trackModel, this);
+	setModel(proxyModel);
 
 	setEditTriggers(QAbstractItemView::NoEditTriggers);
 	setSelectionBehavior(QAbstractItemView::SelectRows);
 	setSelectionMode(QAbstractItemView::ExtendedSelection);
-	setSortingEnabled(true);
 	setRootIsDecorated(false);
 	setAllColumnsShowFocus(true);
-	setColumnCount(columnCount);
-	setHeaderLabels({
-		settings.general.track_numbers == lib::spotify_context::all ? "#" : "",
-		"Title", "Artist", "Album", "Length", "Added"
-	});
+	setUniformRowHeights(true);
 	header()->setSectionsMovable(false);
 	header()->setSortIndicator(settings.general.song_header_sort_by + 1, Qt::AscendingOrder);
+	setSortingEnabled(true);
 
 	updateResizeMode(settings.general.track_list_resize_mode);
 
@@ -39,7 +31,7 @@ List::Tracks::Tracks(lib::spt::api &spotify, lib::settings &settings, lib::cache
 	}
 
 	// Play tracks on click or enter/special key
-	QTreeWidget::connect(this, &QTreeWidget::itemDoubleClicked,
+	QAbstractItemView::connect(this, &QAbstractItemView::doubleClicked,
 		this, &List::Tracks::onDoubleClicked);
 
 	// Song context menu
@@ -55,22 +47,21 @@ List::Tracks::Tracks(lib::spt::api &spotify, lib::settings &settings, lib::cache
 
 void List::Tracks::onMenu(const QPoint &pos)
 {
-	const auto &items = selectedItems();
+	const auto &rows = selectionModel()->selectedRows();
 
 	QList<PlaylistTrack> tracks;
-	tracks.reserve(items.size());
+	tracks.reserve(rows.size());
 
-	for (const auto *item: items)
+	for (const auto &row: rows)
 	{
-		const auto track = item->data(0, static_cast<int>(DataRole::Track))
-			.value<lib::spt::track>();
+		const auto index = proxyModel->mapToSource(row).row();
+		const auto &track = trackModel->at(index);
 
 		if (!track.is_valid())
 		{
 			continue;
 		}
 
-		auto index = item->data(0, static_cast<int>(DataRole::Index)).toInt();
 		tracks.push_back(PlaylistTrack(index, track));
 	}
 
@@ -83,24 +74,24 @@ void List::Tracks::onMenu(const QPoint &pos)
 	songMenu->popup(mapToGlobal(pos));
 }
 
-void List::Tracks::onDoubleClicked(QTreeWidgetItem *item, int /*column*/)
+void List::Tracks::onDoubleClicked(const QModelIndex &index)
 {
-	if (item->isDisabled())
+	if (!index.isValid() || !index.flags().testFlag(Qt::ItemIsEnabled))
 	{
 		return;
 	}
 
 	auto *mainWindow = MainWindow::find(parentWidget());
 
-	bool indexFound;
-	auto trackIndex = item->data(0, static_cast<int>(DataRole::Index)).toInt(&indexFound);
-	if (!indexFound)
+	const auto trackIndex = proxyModel->mapToSource(index).row();
+	if (trackIndex < 0 || trackIndex >= trackModel->rowCount())
 	{
 		StatusMessage::error(QStringLiteral("Failed to start playback: track not found"));
 		return;
 	}
 
-	auto callback = [this, mainWindow, item](const std::string &status)
+	const auto trackId = trackModel->at(trackIndex).id;
+	auto callback = [this, mainWindow, trackId](const std::string &status)
 	{
 		if (!status.empty())
 		{
@@ -109,7 +100,7 @@ void List::Tracks::onDoubleClicked(QTreeWidgetItem *item, int /*column*/)
 		}
 		else
 		{
-			this->setPlayingTrackItem(item);
+			this->setPlayingTrackItem(trackId);
 		}
 
 		mainWindow->refresh();
@@ -118,8 +109,8 @@ void List::Tracks::onDoubleClicked(QTreeWidgetItem *item, int /*column*/)
 	const auto &context = mainWindow->getSptContext();
 	if (context.empty())
 	{
-		auto allTracks = mainWindow->currentTracks();
-		this->spotify.play_tracks(currentIndex().row(), allTracks, callback);
+		auto allTracks = currentTracks();
+		this->spotify.play_tracks(index.row(), allTracks, callback);
 	}
 	else
 	{
@@ -246,80 +237,50 @@ void List::Tracks::updateResizeMode(lib::resize_mode mode)
 	resizeHeaders(size());
 }
 
-auto List::Tracks::getAddedText(const std::string &date) const -> QString
+void List::Tracks::load(const std::vector<lib::spt::track> &tracks,
+	const std::string &selectedId, const std::string &addedAt)
 {
-	if (date.empty())
-	{
-		return {};
-	}
+	loadGeneration++;
+	showTracks(tracks, selectedId, addedAt);
+}
 
-	if (settings.general.relative_added)
+void List::Tracks::showTracks(const std::vector<lib::spt::track> &tracks,
+	const std::string &selectedId, const std::string &addedAt)
+{
+	trackModel->load(tracks, addedAt);
+	trackModel->setPlayingTrack(getCurrent().playback.item.id);
+
+	const auto selectedRow = trackModel->rowOf(selectedId);
+	if (selectedRow >= 0)
 	{
-		return DateTime::toRelative(date);
+		const auto selected = proxyModel->index(proxyModel->proxyRow(selectedRow), 0);
+		setCurrentIndex(selected);
+		scrollTo(selected);
 	}
 
-	const auto locale = QLocale::system();
-	const auto parsed = DateTime::parseIsoDate(date).date();
-
-	return parsed.isValid()
-		? locale.toString(parsed, QLocale::ShortFormat)
-		: QString();
+	updateAddedColumn();
 }
 
-void List::Tracks::load(const std::vector<lib::spt::track> &tracks,
-	const std::string &selectedId, const std::string &addedAt)
+void List::Tracks::append(const std::vector<lib::spt::track> &tracks, int total)
 {
-	clear();
-	trackItems.clear();
-	playingTrackItem = nullptr;
-	auto fieldWidth = static_cast<int>(std::to_string(tracks.size()).size());
-	auto current = getCurrent();
-	auto anyHasDate = false;
+	trackModel->add(tracks, total);
 
-	setSortingEnabled(false);
-
-	for (size_t i = 0; i < tracks.size(); i++)
+	const auto &current = getCurrent();
+	for (const auto &track: tracks)
 	{
-		const auto index = static_cast<int>(i);
-		const auto &track = tracks.at(i);
-
-		const auto &added = track.added_at.empty() && !addedAt.empty()
-			? addedAt
-			: track.added_at;
-
-		auto *item = new ListItem::Track({
-			settings.general.track_numbers == lib::spotify_context::all
-				? QString("%1").arg(i + 1, fieldWidth)
-				: QString(),
-			QString::fromStdString(track.name),
-			QString::fromStdString(lib::spt::entity::combine_names(track.artists)),
-			QString::fromStdString(track.album.name),
-			QString::fromStdString(lib::format::time(track.duration)),
-			getAddedText(added),
-		}, track, emptyIcon, index);
-
-		if (!anyHasDate && !added.empty())
-		{
-			anyHasDate = true;
-		}
-
 		if (track.id == current.playback.item.id)
 		{
-			setPlayingTrackItem(item);
-		}
-
-		insertTopLevelItem(index, item);
-		trackItems[track.id] = item;
-
-		if (!selectedId.empty() && track.id == selectedId)
-		{
-			setCurrentItem(item);
+			trackModel->setPlayingTrack(track.id);
+			break;
 		}
 	}
 
-	setSortingEnabled(true);
+	updateAddedColumn();
+}
 
-	header()->setSectionHidden(static_cast<int>(Column::Added), !anyHasDate
+void List::Tracks::updateAddedColumn()
+{
+	header()->setSectionHidden(static_cast<int>(Column::Added), !trackModel->hasAddedAt()
 		|| lib::set::contains(settings.general.hidden_song_headers,
 			static_cast<int>(Column::Added)));
 }
@@ -336,13 +297,23 @@ void List::Tracks::load(const std::vector<lib::spt::track> &tracks, const std::s
 
 void List::Tracks::load(const lib::spt::playlist &playlist)
 {
+	lib::spt::playlist cachedPlaylist;
+	if (playlist.tracks.empty())
+	{
+		cachedPlaylist = cache.get_playlist(playlist.id);
+	}
+
+	// Cached playlists may not have any tracks
+	const auto cached = !playlist.tracks.empty() || !cachedPlaylist.id.empty();
 	const auto &tracks = playlist.tracks.empty()
-		? cache.get_playlist(playlist.id).tracks
+		? cachedPlaylist.tracks
 		: playlist.tracks;
 
-	if (!tracks.empty())
+	const auto generation = ++loadGeneration;
+	if (cached)
 	{
-		load(tracks);
+		showTracks(tracks, std::string(), std::string());
+		setEnabled(true);
 	}
 	else
 	{
@@ -351,21 +322,24 @@ void List::Tracks::load(const lib::spt::playlist &playlist)
 
 	auto *mainWindow = MainWindow::find(parentWidget());
 
-	const auto &snapshot = playlist.snapshot;
 	spotify.playlist(playlist.id,
-		[this, snapshot, mainWindow](const lib::spt::playlist &loadedPlaylist)
+		[this, generation, cached](const lib::spt::playlist &loadedPlaylist)
 		{
-			const auto &currentUser = mainWindow != nullptr
-				? mainWindow->getCurrentUser()
-				: lib::spt::user();
-
-			if (this->isEnabled()
-				&& this->topLevelItemCount() == loadedPlaylist.tracks_total
-				&& loadedPlaylist.is_up_to_date(snapshot, currentUser))
+			// Nothing cached, show tracks as they're loaded
+			if (!cached)
 			{
+				this->refreshPlaylist(loadedPlaylist);
 				return;
 			}
-			this->refreshPlaylist(loadedPlaylist);
+
+			lib::spt::playlist_sync::sync(spotify, cache, loadedPlaylist,
+				[this, generation](const lib::spt::playlist &synced, bool changed)
+				{
+					if (changed && generation == this->loadGeneration)
+					{
+						this->showTracks(synced.tracks, std::string(), std::string());
+					}
+				});
 		});
 
 	if (mainWindow != nullptr)
@@ -380,19 +354,64 @@ void List::Tracks::load(const lib::spt::playlist &playlist)
 void List::Tracks::refreshPlaylist(const lib::spt::playlist &playlist)
 {
 	auto *mainWindow = MainWindow::find(parentWidget());
-	if (lib::spt::api::to_uri("playlist", playlist.id) != mainWindow->getSptContext())
+	const auto context = lib::spt::api::to_uri("playlist", playlist.id);
+	if (context != mainWindow->getSptContext())
+	{
+		return;
+	}
+
+	const auto generation = ++loadGeneration;
+
+	// Already loading, show what's loaded so far and keep adding to it
+	const auto loading = playlistLoads.find(context);
+	if (loading != playlistLoads.end())
 	{
+		loading->second->generation = generation;
+		showTracks(loading->second->tracks, std::string(), std::string());
+		if (!loading->second->tracks.empty())
+		{
+			setEnabled(true);
+		}
 		return;
 	}
 
+	auto load = std::make_shared<PlaylistLoad>();
+	load->generation = generation;
+	if (playlist.tracks_total > 0)
+	{
+		load->tracks.reserve(playlist.tracks_total);
+	}
+	playlistLoads[context] = load;
+
 	spotify.playlist_tracks(playlist,
-		[this, playlist](const std::vector<lib::spt::track> &tracks)
+		[this, playlist, context, load]
+		(const std::vector<lib::spt::track> &page, bool isLast)
 		{
-			auto newPlaylist = playlist;
-			newPlaylist.tracks = tracks;
-			this->load(newPlaylist.tracks);
-			this->setEnabled(true);
-			this->cache.set_playlist(newPlaylist);
+			const auto offset = load->tracks.size();
+			lib::vector::append(load->tracks, page);
+
+			// Other tracks may have been loaded while loading
+			if (load->generation == this->loadGeneration)
+			{
+				if (offset == 0)
+				{
+					this->showTracks(page, std::string(), std::string());
+				}
+				else
+				{
+					this->append(page, playlist.tracks_total);
+				}
+				this->setEnabled(true);
+			}
+
+			if (isLast)
+			{
+				this->playlistLoads.erase(context);
+
+				auto newPlaylist = playlist;
+				newPlaylist.tracks = load->tracks;
+				this->cache.set_playlist(newPlaylist);
+			}
 		});
 }
 
@@ -425,27 +444,44 @@ void List::Tracks::load(const lib::spt::album &album, const std::string &trackId
 		});
 }
 
-void List::Tracks::setPlayingTrackItem(QTreeWidgetItem *item)
+void List::Tracks::setPlayingTrackItem(const std::string &itemId)
 {
-	if (playingTrackItem != nullptr)
-	{
-		playingTrackItem->setIcon(0, emptyIcon);
-	}
+	trackModel->setPlayingTrack(itemId);
+}
+
+void List::Tracks::setTrackNumbers(bool enabled)
+{
+	trackModel->setTrackNumbers(enabled);
+}
+
+auto List::Tracks::trackCount() const -> int
+{
+	return trackModel->rowCount();
+}
+
+auto List::Tracks::currentTracks() const -> std::vector<std::string>
+{
+	const auto count = proxyModel->rowCount();
+
+	std::vector<std::string> tracks;
+	tracks.reserve(count);
 
-	if (item == nullptr)
+	for (auto i = 0; i < count; i++)
 	{
-		playingTrackItem = nullptr;
-		return;
+		const auto &track = trackModel->at(proxyModel->sourceRow(i));
+		if (!track.is_valid())
+		{
+			continue;
+		}
+		tracks.push_back(lib::spt::api::to_uri("track", track.id));
 	}
-	item->setIcon(0, Icon::get("media-playback-start"));
-	playingTrackItem = item;
+
+	return tracks;
 }
 
-void List::Tracks::setPlayingTrackItem(const std::string &itemId)
+auto List::Tracks::removeTracks(const std::unordered_set<std::string> &trackIds) -> int
 {
-	setPlayingTrackItem(trackItems.find(itemId) != trackItems.end()
-		? trackItems[itemId]
-		: nullptr);
+	return trackModel->remove(trackIds);
 }
 
 auto List::Tracks::getCurrent() -> const spt::Current &
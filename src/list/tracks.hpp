@@ -2,16 +2,22 @@
 
 #include "lib/cache.hpp"
 #include "lib/set.hpp"
+#include "lib/spotify/playlistsync.hpp"
 #include "spotify/current.hpp"
 #include "menu/track.hpp"
 #include "enum/column.hpp"
+#include "model/tracklistmodel.hpp"
+#include "model/tracklistproxymodel.hpp"
 
-#include <QListWidget>
-#include <QTreeWidgetItem>
+#include <QTreeView>
+#include <QHeaderView>
+
+#include <memory>
+#include <unordered_map>
 
 namespace List
 {
-	class Tracks: public QTreeWidget
+	class Tracks: public QTreeView
 	{
 	Q_OBJECT
 
@@ -20,8 +26,24 @@ namespace List
 			QWidget *parent);
 
 		void updateResizeMode(lib::resize_mode mode);
-		void setPlayingTrackItem(QTreeWidgetItem *item);
 		void setPlayingTrackItem(const std::string &itemId);
+		void setTrackNumbers(bool enabled);
+
+		/**
+		 * Number of loaded tracks
+		 */
+		auto trackCount() const -> int;
+
+		/**
+		 * URIs of all valid tracks, in the order they're shown
+		 */
+		auto currentTracks() const -> std::vector<std::string>;
+
+		/**
+		 * Remove all tracks with the specified IDs
+		 * @return Number of removed tracks
+		 */
+		auto removeTracks(const std::unordered_set<std::string> &trackIds) -> int;
 
 		/**
 		 * Load tracks directly, without cache, but select an item
@@ -40,6 +62,13 @@ namespace List
 		 */
 		void load(const std::vector<lib::spt::track> &tracks);
 
+		/**
+		 * Add tracks to the end of the list, without clearing it
+		 * @param tracks Tracks to add
+		 * @param total Total number of tracks expected to be loaded
+		 */
+		void append(const std::vector<lib::spt::track> &tracks, int total);
+
 		/**
 		 * Load playlist first from cache, then refresh it
 		 */
@@ -68,17 +97,46 @@ namespace List
 		lib::cache &cache;
 		lib::spt::api &spotify;
 
-		std::unordered_map<std::string, QTreeWidgetItem *> trackItems;
+		TrackListModel *trackModel = nullptr;
+		TrackListProxyModel *proxyModel = nullptr;
 
-		QTreeWidgetItem *playingTrackItem = nullptr;
-		QIcon emptyIcon;
+		/**
+		 * Playlist being loaded one page at a time
+		 */
+		struct PlaylistLoad
+		{
+			std::vector<lib::spt::track> tracks;
+
+			/**
+			 * Load generation pages are shown in
+			 */
+			unsigned int generation = 0;
+		};
+
+		/**
+		 * Increased every time other tracks are loaded,
+		 * anything loaded for an older generation is not shown
+		 */
+		unsigned int loadGeneration = 0;
+
+		/**
+		 * Playlists currently being loaded, by context
+		 */
+		std::unordered_map<std::string, std::shared_ptr<PlaylistLoad>> playlistLoads;
+
+		/**
+		 * Replace tracks, without starting a new load generation
+		 */
+		void showTracks(const std::vector<lib::spt::track> &tracks,
+			const std::string &selectedId,
+			const std::string &addedAt);
 
 		auto getCurrent() -> const spt::Current &;
-		auto getAddedText(const std::string &date) const -> QString;
 		void resizeHeaders(const QSize &newSize);
+		void updateAddedColumn();
 
 		void onMenu(const QPoint &pos);
-		void onDoubleClicked(QTreeWidgetItem *item, int column);
+		void onDoubleClicked(const QModelIndex &index);
 		void onHeaderMenu(const QPoint &pos);
 		void onHeaderMenuTriggered(QAction *action);
 	};
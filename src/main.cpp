@@ -73,6 +73,12 @@ auto main(int argc, char *argv[]) -> int
 	if (parser.isSet("dev"))
 	{
 		lib::developer_mode::enabled = true;
+
+		// Keep messages that no longer fit in memory
+		constexpr size_t maxLogSize = 1024 * 1024;
+		constexpr size_t maxLogFiles = 3;
+		lib::log::get_store().set_spill(paths.cache() / "log" / "spotify-qt.log",
+			maxLogSize, maxLogFiles);
 	}
 
 	if (parser.isSet("paths"))
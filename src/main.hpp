@@ -1,9 +1,14 @@
 #pragma once
 
+#include "lib/cache/binarycache.hpp"
+#include "lib/cache/cacheevictor.hpp"
+#include "lib/cache/databasecache.hpp"
 #include "lib/cache/jsoncache.hpp"
+#include "lib/cache/memorycache.hpp"
 #include "lib/developermode.hpp"
 #include "lib/log.hpp"
 #include "lib/spotify/playback.hpp"
+#include "lib/spotify/playbackstate.hpp"
 #include "lib/spotify/playlist.hpp"
 #include "lib/spotify/user.hpp"
 #include "lib/qt/httpclient.hpp"
@@ -15,7 +20,7 @@
 #include "dialog/whatsnew.hpp"
 #include "list/library.hpp"
 #include "list/playlist.hpp"
-#include "listitem/track.hpp"
+#include "model/tracklistmodel.hpp"
 #include "mediaplayer/service.hpp"
 #include "menu/mainmenu.hpp"
 #include "menu/playlist.hpp"
@@ -35,7 +40,10 @@
 #include "view/trayicon.hpp"
 #include "widget/hiddensizegrip.hpp"
 
+#include <QElapsedTimer>
 #include <QMainWindow>
 #include <QSplitter>
 #include <QStatusBar>
 #include <QSizeGrip>
+
+#include <memory>
@@ -4,7 +4,10 @@
 MainWindow::MainWindow(lib::settings &settings, lib::paths &paths)
 	: settings(settings),
 	paths(paths),
-	cache(paths)
+	cacheHandler(createCache(settings, paths)),
+	cache(*cacheHandler),
+	albumCacheEvictor(new lib::cache_evictor(paths.cache() / "album",
+		albumCacheLimit(settings), std::chrono::minutes(10)))
 {
 	lib::crash_handler::set_cache(cache);
 
@@ -47,6 +50,7 @@ MainWindow::MainWindow(lib::settings &settings, lib::paths &paths)
 	// Set Spotify
 	splash.showMessage("Connecting...");
 	httpClient = new lib::qt::http_client(this);
+	imageLoader.reset(new lib::image_loader(*httpClient, cache, Http::maxRequestsPerHost));
 	spotify = new spt::Spotify(settings, *httpClient, this);
 
 	// Check connection
@@ -63,17 +67,18 @@ MainWindow::MainWindow(lib::settings &settings, lib::paths &paths)
 	resize(defaultSize());
 	setCentralWidget(createCentralWidget());
 	toolBar = new MainToolBar(*spotify, settings,
-		*httpClient, cache, this);
+		*httpClient, *imageLoader, cache, this);
 	addToolBar(Qt::ToolBarArea::TopToolBarArea, toolBar);
 	setContextMenuPolicy(Qt::NoContextMenu);
+	connectPlaybackChanges();
 
 	// Update player status
 	splash.showMessage("Refreshing...");
-	auto *timer = new QTimer(this);
-	QTimer::connect(timer, &QTimer::timeout, this, &MainWindow::refresh);
+	refreshTimer = new QTimer(this);
+	refreshTimer->setSingleShot(true);
+	QTimer::connect(refreshTimer, &QTimer::timeout, this, &MainWindow::tick);
 	refresh();
-	constexpr int tickMs = 1000;
-	timer->start(tickMs);
+	scheduleTick();
 	splash.showMessage("Welcome!");
 
 	// Start client if set
@@ -117,6 +122,67 @@ void MainWindow::closeEvent(QCloseEvent *event)
 	}
 }
 
+void MainWindow::showEvent(QShowEvent *event)
+{
+	QMainWindow::showEvent(event);
+	playbackVisibilityChanged();
+}
+
+void MainWindow::changeEvent(QEvent *event)
+{
+	QMainWindow::changeEvent(event);
+
+	if (event->type() == QEvent::WindowStateChange)
+	{
+		playbackVisibilityChanged();
+	}
+}
+
+void MainWindow::playbackVisibilityChanged()
+{
+	// Progress isn't updated while hidden
+	if (isPlaybackVisible() && current.playback.item.is_valid())
+	{
+		emit progressChanged(playbackState.progress_ms(), current.playback.item.duration);
+	}
+
+	scheduleTick();
+}
+
+auto MainWindow::createCache(const lib::settings &settings,
+	const lib::paths &paths) -> std::unique_ptr<lib::cache>
+{
+	// Maximum weight of albums, playlists and track lists, each, to keep in memory,
+	// where albums count 1 and track lists count their tracks + 1
+	constexpr size_t maxMemoryItems = 50000;
+	constexpr std::chrono::milliseconds writeDelay(1000);
+
+	std::unique_ptr<lib::cache> diskCache;
+
+	switch (settings.general.cache_type)
+	{
+		case lib::cache_type::json:
+			diskCache.reset(new lib::json_cache(paths));
+			break;
+
+		case lib::cache_type::binary:
+			diskCache.reset(new lib::binary_cache(paths));
+			break;
+
+		case lib::cache_type::database:
+			diskCache.reset(new lib::database_cache(paths));
+			break;
+	}
+
+	if (!diskCache)
+	{
+		diskCache.reset(new lib::json_cache(paths));
+	}
+
+	return std::unique_ptr<lib::cache>(new lib::memory_cache(std::move(diskCache),
+		maxMemoryItems, writeDelay));
+}
+
 void MainWindow::initClient()
 {
 	if (!settings.spotify.start_client)
@@ -256,103 +322,197 @@ void MainWindow::minimize()
 }
 
 void MainWindow::refresh()
+{
+	lastRefresh.start();
+
+	spotify->current_playback([this](const lib::spt::playback &playback)
+	{
+		refreshed(playback);
+	});
+}
+
+void MainWindow::tick()
+{
+	if (!lastRefresh.isValid() || lastRefresh.elapsed() >= refreshInterval().count())
+	{
+		refresh();
+	}
+	else if (current.playback.is_playing && isPlaybackVisible())
+	{
+		emit progressChanged(playbackState.progress_ms(), current.playback.item.duration);
+	}
+
+	scheduleTick();
+}
+
+void MainWindow::scheduleTick()
 {
 	constexpr int msInSec = 1000;
 
-	if (refreshCount < 0
-		|| ++refreshCount >= settings.general.refresh_interval
-		|| current.playback.progress_ms + msInSec > current.playback.item.duration)
+	if (refreshTimer == nullptr)
 	{
-		spotify->current_playback([this](const lib::spt::playback &playback)
-		{
-			refreshed(playback);
-		});
-		refreshCount = 0;
 		return;
 	}
 
-	// Assume last refresh was 1 sec ago
-	if (!current.playback.is_playing)
+	const auto interval = static_cast<qint64>(refreshInterval().count());
+	auto next = lastRefresh.isValid()
+		? std::max(interval - lastRefresh.elapsed(), qint64(0))
+		: qint64(0);
+
+	// Update progress when the next second starts, but only if it can be seen
+	if (current.playback.is_playing && isPlaybackVisible())
 	{
-		return;
+		next = std::min(next, qint64(msInSec - playbackState.progress_ms() % msInSec));
 	}
-	current.playback.progress_ms += msInSec;
-	refreshed(current.playback);
+
+	refreshTimer->start(static_cast<int>(next));
+}
+
+auto MainWindow::refreshInterval() const -> std::chrono::milliseconds
+{
+	return playbackState.poll_interval(std::chrono::seconds(settings.general.refresh_interval),
+		isPlaybackVisible());
+}
+
+auto MainWindow::isPlaybackVisible() const -> bool
+{
+	return isVisible() && !isMinimized();
 }
 
 void MainWindow::refreshed(const lib::spt::playback &playback)
 {
-	const auto trackChange = playback.is_playing
-		&& current.playback.is_playing
-		&& playback.item.id != current.playback.item.id;
+	const auto wasPlaying = playbackState.get().is_playing;
+	const auto changes = playbackState.update(playback);
 
 	current.playback = playback;
 
 	if (!current.playback.item.is_valid())
 	{
-		toolBar->setPlaying(false);
-		contextView->resetCurrentlyPlaying();
-		setWindowTitle(APP_NAME);
+		if (changes.track)
+		{
+			contextView->resetCurrentlyPlaying();
+			setWindowTitle(APP_NAME);
+		}
+		if (changes.playing || changes.track)
+		{
+			toolBar->setPlaying(false);
+		}
 		return;
 	}
 
-	const auto &currPlaying = current.playback.item;
-	if (contextView->getCurrentlyPlaying().id != currPlaying.id
-		|| windowTitle() == APP_NAME)
+	if (changes.track)
 	{
-		if (current.playback.is_playing)
-		{
-			mainContent->getTracksList()->setPlayingTrackItem(currPlaying.id);
-		}
+		currentTrackChanged(playback.is_playing && wasPlaying);
+		emit trackChanged(current.playback.item);
+	}
 
-		const auto &albumImageUrl = settings.general.expand_album_cover
-			? currPlaying.image_large()
-			: currPlaying.image_small();
+	if (changes.playing)
+	{
+		emit playingChanged(current.playback.is_playing);
+	}
 
-		contextView->setCurrentlyPlaying(currPlaying);
-		setAlbumImage(currPlaying.album, albumImageUrl);
-		setWindowTitle(QString::fromStdString(currPlaying.title()));
-		contextView->updateContextIcon();
+	if (changes.progress)
+	{
+		emit progressChanged(current.playback.progress_ms, current.playback.item.duration);
+	}
 
-#ifdef USE_DBUS
-		if (mediaPlayer != nullptr)
+	if (changes.volume)
+	{
+		emit volumeChanged(current.playback.volume());
+	}
+
+	if (changes.shuffle)
+	{
+		emit shuffleChanged(current.playback.shuffle);
+	}
+
+	if (changes.repeat)
+	{
+		emit repeatChanged(current.playback.repeat);
+	}
+
+	if (changes.playing || changes.progress)
+	{
+		scheduleTick();
+	}
+}
+
+void MainWindow::connectPlaybackChanges()
+{
+	MainWindow::connect(this, &MainWindow::trackChanged,
+		[this](const lib::spt::track &track)
 		{
-			mediaPlayer->currentSourceChanged(current.playback);
-		}
-#endif
+			if (current.playback.is_playing)
+			{
+				mainContent->getTracksList()->setPlayingTrackItem(track.id);
+			}
+		});
+
+	MainWindow::connect(this, &MainWindow::playingChanged,
+		toolBar, &MainToolBar::setPlaying);
 
-		if (trayIcon != nullptr
-			&& (settings.general.tray_album_art || settings.general.notify_track_change))
+	MainWindow::connect(this, &MainWindow::progressChanged,
+		[this](int progress, int duration)
 		{
-			Http::getAlbum(current.playback.item.image_small(), *httpClient, cache, false,
-				[this, &currPlaying, trackChange](const QPixmap &image)
-				{
-					if (trayIcon == nullptr)
-					{
-						return;
-					}
-
-					if (settings.general.tray_album_art)
-					{
-						trayIcon->setPixmap(image);
-					}
-
-					if (settings.general.notify_track_change && trackChange)
-					{
-						trayIcon->message(currPlaying, image);
-					}
-				});
-		}
+			toolBar->setProgress(progress, duration);
+		});
+
+	MainWindow::connect(this, &MainWindow::volumeChanged,
+		[this](int volume)
+		{
+			constexpr int volumeStep = 5;
+			toolBar->setVolume(volume / volumeStep);
+		});
+
+	MainWindow::connect(this, &MainWindow::shuffleChanged,
+		toolBar, &MainToolBar::setShuffle);
+
+	MainWindow::connect(this, &MainWindow::repeatChanged,
+		toolBar, &MainToolBar::setRepeat);
+}
+
+void MainWindow::currentTrackChanged(bool notify)
+{
+	const auto &currPlaying = current.playback.item;
+
+	const auto &albumImageUrl = settings.general.expand_album_cover
+		? currPlaying.image_large()
+		: currPlaying.image_small();
+
+	contextView->setCurrentlyPlaying(currPlaying);
+	setAlbumImage(currPlaying.album, albumImageUrl);
+	setWindowTitle(QString::fromStdString(currPlaying.title()));
+	contextView->updateContextIcon();
+
+#ifdef USE_DBUS
+	if (mediaPlayer != nullptr)
+	{
+		mediaPlayer->currentSourceChanged(current.playback);
 	}
+#endif
 
-	toolBar->setProgress(current.playback);
-	toolBar->setPlaying(current.playback.is_playing);
+	if (trayIcon != nullptr
+		&& (settings.general.tray_album_art || settings.general.notify_track_change))
+	{
+		Http::getAlbum(currPlaying.image_small(), *imageLoader, false,
+			[this, &currPlaying, notify](const QPixmap &image)
+			{
+				if (trayIcon == nullptr)
+				{
+					return;
+				}
 
-	constexpr int volumeStep = 5;
-	toolBar->setVolume(current.playback.volume() / volumeStep);
+				if (settings.general.tray_album_art)
+				{
+					trayIcon->setPixmap(image);
+				}
 
-	toolBar->setRepeat(current.playback.repeat);
-	toolBar->setShuffle(current.playback.shuffle);
+				if (settings.general.notify_track_change && notify)
+				{
+					trayIcon->message(currPlaying, image);
+				}
+			});
+	}
 }
 
 auto MainWindow::createCentralWidget() -> QWidget *
@@ -360,7 +520,7 @@ auto MainWindow::createCentralWidget() -> QWidget *
 	// All widgets in container
 	mainContent = new MainContent(*spotify, settings, cache, this);
 	sidePanel = new SidePanel::View(*spotify, settings, cache,
-		*httpClient, this);
+		*httpClient, *imageLoader, this);
 
 	libraryList = new List::Library(*spotify, cache, this);
 	playlistList = new List::Playlist(*spotify, settings, cache, this);
@@ -439,12 +599,12 @@ void MainWindow::saveTracksToCache(const std::string &id,
 void MainWindow::setAlbumImage(const lib::spt::entity &albumEntity,
 	const std::string &albumImageUrl)
 {
-	Http::getAlbum(albumImageUrl, *httpClient, cache,
-		[this, albumEntity](const QPixmap &image)
+	Http::getAlbum(albumImageUrl, *imageLoader, QSize(), this,
+		[this, albumEntity, albumImageUrl](const QPixmap &image)
 		{
 			if (contextView != nullptr)
 			{
-				contextView->setAlbum(albumEntity, image);
+				contextView->setAlbum(albumEntity, albumImageUrl, image);
 			}
 		});
 }
@@ -456,24 +616,7 @@ void MainWindow::openArtist(const std::string &artistId)
 
 auto MainWindow::currentTracks() -> std::vector<std::string>
 {
-	const auto *tracksList = mainContent->getTracksList();
-	const auto tracksCount = tracksList->topLevelItemCount();
-
-	std::vector<std::string> tracks;
-	tracks.reserve(tracksCount);
-
-	for (int i = 0; i < tracksCount; i++)
-	{
-		auto track = tracksList->topLevelItem(i)->data(0, static_cast<int>(DataRole::Track))
-			.value<lib::spt::track>();
-		if (!track.is_valid())
-		{
-			continue;
-		}
-		tracks.push_back(lib::spt::api::to_uri("track", track.id));
-	}
-
-	return tracks;
+	return mainContent->getTracksList()->currentTracks();
 }
 
 void MainWindow::reloadTrayIcon()
@@ -495,6 +638,20 @@ auto MainWindow::getTrayIcon() -> TrayIcon *
 	return trayIcon;
 }
 
+auto MainWindow::getAlbumCacheEvictor() -> lib::cache_evictor &
+{
+	return *albumCacheEvictor;
+}
+
+auto MainWindow::albumCacheLimit(const lib::settings &settings) -> size_t
+{
+	constexpr size_t bytesInMegabyte = 1024 * 1024;
+
+	return settings.general.album_cache_size > 0
+		? static_cast<size_t>(settings.general.album_cache_size) * bytesInMegabyte
+		: 0;
+}
+
 void MainWindow::setFixedWidthTime(bool value)
 {
 	toolBar->setPositionFont(value
@@ -504,16 +661,7 @@ void MainWindow::setFixedWidthTime(bool value)
 
 void MainWindow::toggleTrackNumbers(bool enabled)
 {
-	const auto *tracksList = mainContent->getTracksList();
-
-	for (int i = 0; i < tracksList->topLevelItemCount(); i++)
-	{
-		auto *item = tracksList->topLevelItem(i);
-		item->setText(0, enabled
-			? QString("%1").arg(item->data(0, static_cast<int>(DataRole::Index))
-				.toInt() + 1, 3)
-			: QString());
-	}
+	mainContent->getTracksList()->setTrackNumbers(enabled);
 }
 
 void MainWindow::toggleExpandableAlbum(bool shouldBeExpandable)
@@ -525,7 +673,9 @@ void MainWindow::toggleExpandableAlbum(bool shouldBeExpandable)
 
 auto MainWindow::currentPlayback() const -> lib::spt::playback
 {
-	return current.playback;
+	auto playback = current.playback;
+	playback.progress_ms = playbackState.progress_ms();
+	return playback;
 }
 
 auto MainWindow::getCurrentUser() const -> const lib::spt::user &
@@ -576,6 +726,8 @@ void MainWindow::setNoSptContext()
 
 auto MainWindow::getCurrentPlayback() -> lib::spt::playback &
 {
+	// Playback may be changed, and refreshed, with current progress
+	current.playback.progress_ms = playbackState.progress_ms();
 	return current.playback;
 }
 
@@ -642,11 +794,6 @@ void MainWindow::setCurrentPlaylistItem(int index)
 	playlistList->setCurrentRow(index);
 }
 
-auto MainWindow::allArtists() -> std::unordered_set<std::string>
-{
-	return playlistList->allArtists();
-}
-
 auto MainWindow::getCurrentPlaylistItem() -> QListWidgetItem *
 {
 	return playlistList->currentItem();
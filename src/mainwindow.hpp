@@ -27,12 +27,26 @@ public:
 	void openLyrics(const lib::spt::track &track);
 	void reloadTrayIcon();
 	auto getTrayIcon() -> TrayIcon *;
+	auto getAlbumCacheEvictor() -> lib::cache_evictor &;
+
+	/**
+	 * Album cover cache limit in bytes from settings
+	 */
+	static auto albumCacheLimit(const lib::settings &settings) -> size_t;
 	auto getCurrentUser() const -> const lib::spt::user &;
 	void setFixedWidthTime(bool value);
 	std::vector<lib::spt::track> loadTracksFromCache(const std::string &id);
 	void saveTracksToCache(const std::string &id, const std::vector<lib::spt::track> &tracks);
 	std::vector<std::string> currentTracks();
+
+	/**
+	 * Request current playback now
+	 */
 	void refresh();
+
+	/**
+	 * Update current playback, and notify about what changed
+	 */
 	void refreshed(const lib::spt::playback &playback);
 	void toggleTrackNumbers(bool enabled);
 	void toggleExpandableAlbum(bool shouldBeExpandable);
@@ -43,7 +57,6 @@ public:
 	void setCurrentLibraryItem(QTreeWidgetItem *item);
 	lib::spt::playlist getPlaylist(int index);
 	void setCurrentPlaylistItem(int index);
-	std::unordered_set<std::string> allArtists();
 	QListWidgetItem *getCurrentPlaylistItem();
 	int getPlaylistItemCount();
 	QListWidgetItem *getPlaylistItem(int index);
@@ -73,8 +86,18 @@ public:
 	mp::Service *getMediaPlayer();
 #endif
 
+signals:
+	void trackChanged(const lib::spt::track &track);
+	void playingChanged(bool playing);
+	void progressChanged(int progress, int duration);
+	void volumeChanged(int volume);
+	void shuffleChanged(bool shuffle);
+	void repeatChanged(lib::repeat_state repeat);
+
 protected:
 	void closeEvent(QCloseEvent *event) override;
+	void showEvent(QShowEvent *event) override;
+	void changeEvent(QEvent *event) override;
 
 private:
 	MainContent *mainContent = nullptr;
@@ -88,12 +111,17 @@ private:
 
 	lib::settings &settings;
 	lib::paths &paths;
-	lib::json_cache cache;
+	std::unique_ptr<lib::cache> cacheHandler;
+	lib::cache &cache;
+	std::unique_ptr<lib::cache_evictor> albumCacheEvictor;
 	lib::spt::user currentUser;
 	lib::http_client *httpClient = nullptr;
+	std::unique_ptr<lib::image_loader> imageLoader;
 
 	TrayIcon *trayIcon = nullptr;
-	int refreshCount = -1;
+	lib::spt::playback_state playbackState;
+	QElapsedTimer lastRefresh;
+	QTimer *refreshTimer = nullptr;
 	bool stateValid = true;
 	QDockWidget *sidePanel = nullptr;
 
@@ -106,6 +134,8 @@ private:
 #endif
 
 	// Initialization
+	static auto createCache(const lib::settings &settings,
+		const lib::paths &paths) -> std::unique_ptr<lib::cache>;
 	void initClient();
 	void initMediaController();
 	void initWhatsNew();
@@ -113,6 +143,13 @@ private:
 
 	// Methods
 	QWidget *createCentralWidget();
+	void connectPlaybackChanges();
+	void tick();
+	void scheduleTick();
+	auto refreshInterval() const -> std::chrono::milliseconds;
+	auto isPlaybackVisible() const -> bool;
+	void playbackVisibilityChanged();
+	void currentTrackChanged(bool notify);
 	void setAlbumImage(const lib::spt::entity &albumEntity, const std::string &albumImageUrl);
 	void setSptContext(const std::string &uri);
 };
@@ -2,14 +2,17 @@
 #include "mainwindow.hpp"
 #include "dialog/createplaylist.hpp"
 #include "dialog/addtoplaylist.hpp"
+#include "lib/qt/httpclient.hpp"
 
 DeveloperMenu::DeveloperMenu(lib::settings &settings, lib::spt::api &spotify,
-	lib::cache &cache, const lib::http_client &httpClient, QWidget *parent)
+	lib::cache &cache, const lib::http_client &httpClient,
+	lib::image_loader &imageLoader, QWidget *parent)
 	: QMenu("Developer", parent),
 	settings(settings),
 	spotify(spotify),
 	cache(cache),
-	httpClient(httpClient)
+	httpClient(httpClient),
+	imageLoader(imageLoader)
 {
 	setIcon(Icon::get("folder-txt"));
 
@@ -27,18 +30,19 @@ DeveloperMenu::DeveloperMenu(lib::settings &settings, lib::spt::api &spotify,
 
 	addMenuItem(this, "Refresh access token", [this]()
 	{
-		try
+		this->spotify.refresh([this](const std::string &error)
 		{
-			this->spotify.refresh();
+			if (!error.empty())
+			{
+				QMessageBox::critical(this, "Error",
+					QString("Refresh failed: %1").arg(QString::fromStdString(error)));
+				return;
+			}
+
 			QMessageBox::information(this, "Success",
 				QString::fromStdString(lib::fmt::format("Successfully refreshed access token:\n{}",
 					this->settings.account.refresh_token)));
-		}
-		catch (const std::exception &e)
-		{
-			QMessageBox::critical(this, "Error",
-				QString("Refresh failed: %1").arg(e.what()));
-		}
+		});
 	});
 
 	addMenuItem(this, "Load huge playlist (very slow)", [this]()
@@ -65,7 +69,7 @@ DeveloperMenu::DeveloperMenu(lib::settings &settings, lib::spt::api &spotify,
 
 		const auto &track = mainWindow->currentPlayback().item;
 
-		Http::getAlbum(track.image_small(), this->httpClient, this->cache,
+		Http::getAlbum(track.image_small(), this->imageLoader,
 			[trayIcon, &track](const QPixmap &pixmap)
 			{
 				trayIcon->message(track, pixmap);
@@ -139,6 +143,34 @@ auto DeveloperMenu::infoMenu() -> QMenu *
 			QString::fromStdString(mainWindow->getSptContext()));
 	});
 
+	addMenuItem(menu, "Image loader", [this, mainWindow]()
+	{
+		nlohmann::json json = imageLoader.get_stats();
+		QMessageBox::information(mainWindow, "Image loader",
+			QString::fromStdString(json.dump(4)));
+	});
+
+	addMenuItem(menu, "Response cache", [this, mainWindow]()
+	{
+		nlohmann::json json = spotify.get_response_stats();
+		QMessageBox::information(mainWindow, "Response cache",
+			QString::fromStdString(json.dump(4)));
+	});
+
+	addMenuItem(menu, "Request latency", [this, mainWindow]()
+	{
+		const auto *client = dynamic_cast<const lib::qt::http_client *>(&httpClient);
+		if (client == nullptr)
+		{
+			StatusMessage::warn(QStringLiteral("HTTP client has no scheduler"));
+			return;
+		}
+
+		nlohmann::json json = client->get_scheduler();
+		QMessageBox::information(mainWindow, "Request latency",
+			QString::fromStdString(json.dump(4)));
+	});
+
 	return menu;
 }
 
@@ -9,6 +9,7 @@
 #include "lib/settings.hpp"
 #include "lib/spotify/api.hpp"
 #include "lib/httpclient.hpp"
+#include "lib/imageloader.hpp"
 #include "view/debugview.hpp"
 
 #include <QMenu>
@@ -20,13 +21,15 @@ Q_OBJECT
 
 public:
 	DeveloperMenu(lib::settings &settings, lib::spt::api &spotify,
-		lib::cache &cache, const lib::http_client &httpClient, QWidget *parent);
+		lib::cache &cache, const lib::http_client &httpClient,
+		lib::image_loader &imageLoader, QWidget *parent);
 
 private:
 	lib::settings &settings;
 	lib::spt::api &spotify;
 	lib::cache &cache;
 	const lib::http_client &httpClient;
+	lib::image_loader &imageLoader;
 
 	static void addMenuItem(QMenu *menu, const QString &text,
 		const std::function<void()> &triggered);
@@ -2,12 +2,14 @@
 #include "mainwindow.hpp"
 
 MainMenu::MainMenu(lib::spt::api &spotify, lib::settings &settings,
-	const lib::http_client &httpClient, lib::cache &cache, QWidget *parent)
+	const lib::http_client &httpClient, lib::image_loader &imageLoader,
+	lib::cache &cache, QWidget *parent)
 	: QMenu(parent),
 	spotify(spotify),
 	settings(settings),
 	cache(cache),
-	httpClient(httpClient)
+	httpClient(httpClient),
+	imageLoader(imageLoader)
 {
 	// Update notifier
 	about = addAction(Icon::get("help-about"), QString("Checking for updates..."));
@@ -41,7 +43,7 @@ MainMenu::MainMenu(lib::spt::api &spotify, lib::settings &settings,
 	if (lib::developer_mode::enabled)
 	{
 		addMenu(new DeveloperMenu(settings, spotify, cache,
-			httpClient, this));
+			httpClient, imageLoader, this));
 	}
 
 	// Log out and quit
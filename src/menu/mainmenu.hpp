@@ -14,13 +14,14 @@ Q_OBJECT
 
 public:
 	MainMenu(lib::spt::api &spotify, lib::settings &settings, const lib::http_client &httpClient,
-		lib::cache &cache, QWidget *parent);
+		lib::image_loader &imageLoader, lib::cache &cache, QWidget *parent);
 
 private:
 	lib::spt::api &spotify;
 	lib::settings &settings;
 	lib::cache &cache;
 	const lib::http_client &httpClient;
+	lib::image_loader &imageLoader;
 	QAction *about;
 	QMenu *deviceMenu;
 
@@ -49,18 +49,14 @@ Menu::Playlist::Playlist(lib::spt::api &spotify, const lib::spt::playlist &playl
 		tracksLoaded(cached.tracks);
 	}
 
-	const auto *mainWindow = MainWindow::find(parentWidget());
-	const auto &currentUser = mainWindow != nullptr
-		? mainWindow->getCurrentUser()
-		: lib::spt::user();
-
-	if (cached.is_null() || !playlist.is_up_to_date(cached.snapshot, currentUser))
-	{
-		spotify.playlist_tracks(playlist, [this](const std::vector<lib::spt::track> &items)
+	lib::spt::playlist_sync::sync(spotify, cache, playlist,
+		[this](const lib::spt::playlist &synced, bool changed)
 		{
-			tracksLoaded(items);
+			if (changed)
+			{
+				tracksLoaded(synced.tracks);
+			}
 		});
-	}
 }
 
 void Menu::Playlist::showEvent(QShowEvent *event)
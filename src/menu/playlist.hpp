@@ -3,6 +3,7 @@
 #include "dialog/playlistedit.hpp"
 #include "lib/spotify/api.hpp"
 #include "lib/cache.hpp"
+#include "lib/spotify/playlistsync.hpp"
 #include "lib/random.hpp"
 
 #include <QInputDialog>
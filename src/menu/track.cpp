@@ -351,33 +351,12 @@ void Menu::Track::onRemoveFromPlaylist(bool /*checked*/)
 
 			// Remove from interface
 			auto *mainWindow = MainWindow::find(this->parentWidget());
-			QList<int> toRemove;
-
-			for (auto i = 0; i < mainWindow->getSongsTree()->topLevelItemCount(); i++)
-			{
-				auto *item = mainWindow->getSongsTree()->topLevelItem(i);
-
-				const auto &trackId = item->data(0,
-					static_cast<int>(DataRole::Track)).value<lib::spt::track>().id;
-
-				if (trackIds.count(trackId) > 0)
-				{
-					toRemove.append(i);
-				}
-			}
-
-			if (toRemove.empty())
+			if (mainWindow->getSongsTree()->removeTracks(trackIds) == 0)
 			{
 				lib::log::warn("Failed to remove track from list");
 				return;
 			}
 
-			// It doesn't necessarily match item index depending on sorting order
-			for (const auto index: toRemove)
-			{
-				mainWindow->getSongsTree()->takeTopLevelItem(index);
-			}
-
 			// Refresh the playlist automatically to prevent issues with songs being skipped
 			mainWindow->getSongsTree()->refreshPlaylist(currentPlaylist);
 
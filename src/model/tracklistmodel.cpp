@@ -1,29 +1,214 @@
-#include "tracklistmodel.hpp"
+#include "model/tracklistmodel.hpp"
+#include "util/icon.hpp"
+#include "lib/format.hpp"
 
-TrackListModel::TrackListModel(QObject *parent)
-	: QAbstractListModel(parent)
+TrackListModel::TrackListModel(const lib::settings &settings, QObject *parent)
+	: QAbstractTableModel(parent),
+	settings(settings),
+	trackNumbers(settings.general.track_numbers == lib::spotify_context::all)
 {
+	constexpr int emptyPixmapSize = 64;
+
+	// Empty icon used as replacement for play icon
+	QPixmap emptyPixmap(emptyPixmapSize, emptyPixmapSize);
+	emptyPixmap.fill(Qt::transparent);
+	emptyIcon = QIcon(emptyPixmap);
+
+	playingIcon = Icon::get("media-playback-start");
+}
+
+void TrackListModel::load(const std::vector<lib::spt::track> &items,
+	const std::string &addedAt)
+{
+	beginResetModel();
+	tracks = items;
+	sortKeys.clear();
+	addSortKeys(items);
+	fallbackAddedAt = addedAt;
+	playingRow = -1;
+	updateFieldWidth(static_cast<int>(tracks.size()));
+	endResetModel();
 }
 
-void TrackListModel::add(const std::vector<lib::spt::track> &items)
+void TrackListModel::add(const std::vector<lib::spt::track> &items, int total)
 {
-	beginInsertRows(QModelIndex(), rowCount(),
-		static_cast<int>(rowCount() + tracks.size() - 1));
+	if (items.empty())
+	{
+		return;
+	}
+
+	const auto count = rowCount();
+	const auto previousWidth = fieldWidth;
+
+	beginInsertRows(QModelIndex(), count,
+		static_cast<int>(count + items.size() - 1));
 	lib::vector::append(tracks, items);
+	addSortKeys(items);
+	updateFieldWidth(std::max(total, rowCount()));
 	endInsertRows();
+
+	// Track numbers of previous rows are now padded differently
+	if (trackNumbers && count > 0 && fieldWidth != previousWidth)
+	{
+		emit dataChanged(index(0, static_cast<int>(Column::Index)),
+			index(count - 1, static_cast<int>(Column::Index)), {
+				Qt::DisplayRole,
+			});
+	}
 }
 
 void TrackListModel::clear()
 {
-	beginRemoveRows(QModelIndex(), 0,
-		static_cast<int>(tracks.size() - 1));
+	beginResetModel();
 	tracks.clear();
-	endRemoveRows();
+	sortKeys.clear();
+	playingRow = -1;
+	endResetModel();
+}
+
+auto TrackListModel::remove(const std::unordered_set<std::string> &trackIds) -> int
+{
+	auto removed = 0;
+
+	for (auto row = rowCount() - 1; row >= 0; row--)
+	{
+		if (trackIds.find(tracks.at(row).id) == trackIds.end())
+		{
+			continue;
+		}
+
+		beginRemoveRows(QModelIndex(), row, row);
+		tracks.erase(tracks.begin() + row);
+		sortKeys.erase(sortKeys.begin() + row);
+		endRemoveRows();
+
+		if (row == playingRow)
+		{
+			playingRow = -1;
+		}
+		else if (row < playingRow)
+		{
+			playingRow--;
+		}
+		removed++;
+	}
+
+	return removed;
+}
+
+auto TrackListModel::at(int row) const -> const lib::spt::track &
+{
+	return tracks.at(row);
+}
+
+auto TrackListModel::getTracks() const -> const std::vector<lib::spt::track> &
+{
+	return tracks;
+}
+
+auto TrackListModel::rowOf(const std::string &trackId) const -> int
+{
+	if (trackId.empty())
+	{
+		return -1;
+	}
+
+	for (size_t i = 0; i < tracks.size(); i++)
+	{
+		if (tracks.at(i).id == trackId)
+		{
+			return static_cast<int>(i);
+		}
+	}
+
+	return -1;
+}
+
+auto TrackListModel::addedAt(int row) const -> const std::string &
+{
+	const auto &track = tracks.at(row);
+	return track.added_at.empty() && !fallbackAddedAt.empty()
+		? fallbackAddedAt
+		: track.added_at;
 }
 
-auto TrackListModel::rowCount(const QModelIndex &/*parent*/) const -> int
+auto TrackListModel::hasAddedAt() const -> bool
 {
-	return static_cast<int>(tracks.size());
+	if (!fallbackAddedAt.empty())
+	{
+		return !tracks.empty();
+	}
+
+	return std::any_of(tracks.cbegin(), tracks.cend(),
+		[](const lib::spt::track &track) -> bool
+		{
+			return !track.added_at.empty();
+		});
+}
+
+auto TrackListModel::sortKey(int row, Column column) const -> const QString &
+{
+	const auto &keys = sortKeys.at(row);
+
+	switch (column)
+	{
+		case Column::Artist:
+			return keys.at(1);
+
+		case Column::Album:
+			return keys.at(2);
+
+		default:
+			return keys.at(0);
+	}
+}
+
+void TrackListModel::setPlayingTrack(const std::string &trackId)
+{
+	const auto row = rowOf(trackId);
+	if (row == playingRow)
+	{
+		return;
+	}
+
+	const auto previousRow = playingRow;
+	playingRow = row;
+
+	for (const auto changedRow: {previousRow, row})
+	{
+		if (changedRow < 0)
+		{
+			continue;
+		}
+
+		const auto changed = index(changedRow, static_cast<int>(Column::Index));
+		emit dataChanged(changed, changed, {
+			Qt::DecorationRole,
+		});
+	}
+}
+
+void TrackListModel::setTrackNumbers(bool enabled)
+{
+	trackNumbers = enabled;
+
+	const auto column = static_cast<int>(Column::Index);
+	emit headerDataChanged(Qt::Horizontal, column, column);
+
+	if (!tracks.empty())
+	{
+		emit dataChanged(index(0, column), index(rowCount() - 1, column), {
+			Qt::DisplayRole,
+		});
+	}
+}
+
+auto TrackListModel::rowCount(const QModelIndex &parent) const -> int
+{
+	// Tracks never have any children
+	return parent.isValid()
+		? 0
+		: static_cast<int>(tracks.size());
 }
 
 auto TrackListModel::rowCount() const -> int
@@ -31,45 +216,244 @@ auto TrackListModel::rowCount() const -> int
 	return rowCount(QModelIndex());
 }
 
-auto TrackListModel::columnCount(const QModelIndex &/*parent*/) const -> int
+auto TrackListModel::columnCount(const QModelIndex &parent) const -> int
 {
 	constexpr int columnCount = 6;
-	return columnCount;
+
+	return parent.isValid()
+		? 0
+		: columnCount;
 }
 
 auto TrackListModel::data(const QModelIndex &index, int role) const -> QVariant
 {
-	if (index.row() < 0 || static_cast<size_t>(index.row()) >= tracks.size())
+	if (!index.isValid() || index.row() >= rowCount())
 	{
 		return {};
 	}
 
-	switch (static_cast<TrackListRole>(role))
+	const auto row = index.row();
+	const auto column = static_cast<Column>(index.column());
+	const auto &track = tracks.at(row);
+
+	switch (role)
 	{
-		case TrackListRole::Track:
-			return QVariant::fromValue(tracks.at(index.row()));
+		case Qt::DisplayRole:
+			return displayText(track, row, column);
+
+		case Qt::ToolTipRole:
+			return toolTip(track, row, column);
+
+		case Qt::DecorationRole:
+			if (column == Column::Index)
+			{
+				return row == playingRow
+					? playingIcon
+					: emptyIcon;
+			}
+			return {};
 
-		case TrackListRole::Index:
-			return index.row();
+		default:
+			break;
+	}
+
+	if (role == static_cast<int>(DataRole::Track))
+	{
+		return QVariant::fromValue(track);
+	}
+
+	if (role == static_cast<int>(DataRole::Index))
+	{
+		return row;
+	}
+
+	if (role == static_cast<int>(DataRole::AddedDate))
+	{
+		return DateTime::parseIso(addedAt(row));
+	}
+
+	if (role == static_cast<int>(DataRole::Length))
+	{
+		return track.duration;
 	}
 
 	return {};
 }
 
-auto TrackListModel::data(const QModelIndex &index) const -> QVariant
+auto TrackListModel::headerData(int section, Qt::Orientation orientation,
+	int role) const -> QVariant
 {
-	return data(index, Qt::DisplayRole);
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+	{
+		return QAbstractTableModel::headerData(section, orientation, role);
+	}
+
+	switch (static_cast<Column>(section))
+	{
+		case Column::Index:
+			return trackNumbers
+				? QStringLiteral("#")
+				: QString();
+
+		case Column::Title:
+			return QStringLiteral("Title");
+
+		case Column::Artist:
+			return QStringLiteral("Artist");
+
+		case Column::Album:
+			return QStringLiteral("Album");
+
+		case Column::Length:
+			return QStringLiteral("Length");
+
+		case Column::Added:
+			return QStringLiteral("Added");
+	}
+
+	return {};
+}
+
+auto TrackListModel::flags(const QModelIndex &index) const -> Qt::ItemFlags
+{
+	auto itemFlags = QAbstractTableModel::flags(index);
+	itemFlags.setFlag(Qt::ItemNeverHasChildren);
+
+	if (index.isValid() && index.row() < rowCount())
+	{
+		const auto &track = tracks.at(index.row());
+		if (track.is_local || !track.is_playable)
+		{
+			itemFlags.setFlag(Qt::ItemIsEnabled, false);
+		}
+	}
+
+	return itemFlags;
 }
 
-auto TrackListModel::roleNames() const -> QHash<int, QByteArray>
+void TrackListModel::updateFieldWidth(int total)
 {
-	return {
-		{static_cast<int>(TrackListRole::Track), "track"},
-		{static_cast<int>(TrackListRole::Index), "index"},
-	};
+	fieldWidth = static_cast<int>(std::to_string(total).size());
+}
+
+void TrackListModel::addSortKeys(const std::vector<lib::spt::track> &items)
+{
+	sortKeys.reserve(tracks.size());
+
+	for (const auto &track: items)
+	{
+		sortKeys.push_back({{
+			toSortKey(track.name),
+			toSortKey(lib::spt::entity::combine_names(track.artists)),
+			toSortKey(track.album.name),
+		}});
+	}
 }
 
-auto TrackListModel::parent(const QModelIndex &/*child*/) const -> QModelIndex
+auto TrackListModel::toSortKey(const std::string &str) -> QString
 {
+	auto key = QString::fromStdString(str).toCaseFolded();
+
+	// Ignore "The" when sorting
+	return key.startsWith(QStringLiteral("the "))
+		? key.mid(4)
+		: key;
+}
+
+auto TrackListModel::displayText(const lib::spt::track &track, int row,
+	Column column) const -> QString
+{
+	switch (column)
+	{
+		case Column::Index:
+			return trackNumbers
+				? QString("%1").arg(row + 1, fieldWidth)
+				: QString();
+
+		case Column::Title:
+			return QString::fromStdString(track.name);
+
+		case Column::Artist:
+			return QString::fromStdString(lib::spt::entity::combine_names(track.artists));
+
+		case Column::Album:
+			return QString::fromStdString(track.album.name);
+
+		case Column::Length:
+			return QString::fromStdString(lib::format::time(track.duration));
+
+		case Column::Added:
+			return addedText(addedAt(row));
+	}
+
+	return {};
+}
+
+auto TrackListModel::toolTip(const lib::spt::track &track, int row,
+	Column column) const -> QString
+{
+	constexpr int msInSec = 1000;
+	constexpr int secsInMin = 60;
+
+	switch (column)
+	{
+		case Column::Index:
+			return {};
+
+		case Column::Title:
+			if (track.is_local)
+			{
+				return QStringLiteral("Local track");
+			}
+			if (!track.is_playable)
+			{
+				return QStringLiteral("Unavailable");
+			}
+			return QString::fromStdString(track.name);
+
+		case Column::Artist:
+			return QString::fromStdString(lib::spt::entity::combine_names(track.artists, "\n"));
+
+		case Column::Album:
+			return QString::fromStdString(track.album.name);
+
+		case Column::Length:
+		{
+			const auto seconds = track.duration / msInSec;
+			return QString("%1m %2s (%3s total)")
+				.arg(seconds / secsInMin)
+				.arg(seconds % secsInMin, 2, 10, QChar('0'))
+				.arg(seconds);
+		}
+
+		case Column::Added:
+		{
+			const auto date = DateTime::parseIso(addedAt(row));
+			return DateTime::isEmpty(date)
+				? QString()
+				: QLocale().toString(date.date());
+		}
+	}
+
 	return {};
 }
+
+auto TrackListModel::addedText(const std::string &date) const -> QString
+{
+	if (date.empty())
+	{
+		return {};
+	}
+
+	if (settings.general.relative_added)
+	{
+		return DateTime::toRelative(date);
+	}
+
+	const auto locale = QLocale::system();
+	const auto parsed = DateTime::parseIsoDate(date).date();
+
+	return parsed.isValid()
+		? locale.toString(parsed, QLocale::ShortFormat)
+		: QString();
+}
@@ -1,36 +1,108 @@
 #pragma once
 
-#include "role/tracklistroles.hpp"
+#include "enum/column.hpp"
+#include "enum/datarole.hpp"
+#include "lib/settings.hpp"
 #include "lib/spotify/track.hpp"
-#include "metatypes.hpp"
 #include "lib/vector.hpp"
+#include "metatypes.hpp"
+#include "util/datetime.hpp"
+
+#include <QAbstractTableModel>
+#include <QIcon>
+#include <QLocale>
+#include <QPixmap>
 
-#include <QAbstractListModel>
+#include <array>
+#include <unordered_set>
 
-class TrackListModel: public QAbstractListModel
+class TrackListModel: public QAbstractTableModel
 {
 Q_OBJECT
 
 public:
-	explicit TrackListModel(QObject *parent);
+	TrackListModel(const lib::settings &settings, QObject *parent);
 
-	void add(const std::vector<lib::spt::track> &tracks);
+	/**
+	 * Replace all tracks
+	 * @param addedAt Fallback added date for tracks without one
+	 */
+	void load(const std::vector<lib::spt::track> &tracks, const std::string &addedAt);
+
+	/**
+	 * Add tracks to the end
+	 * @param total Total number of tracks expected to be loaded
+	 */
+	void add(const std::vector<lib::spt::track> &tracks, int total);
 
 	void clear();
 
+	/**
+	 * Remove all tracks with the specified IDs
+	 * @return Number of removed tracks
+	 */
+	auto remove(const std::unordered_set<std::string> &trackIds) -> int;
+
+	auto at(int row) const -> const lib::spt::track &;
+	auto getTracks() const -> const std::vector<lib::spt::track> &;
+
+	/**
+	 * Row of first track with the specified ID, or -1 if none
+	 */
+	auto rowOf(const std::string &trackId) const -> int;
+
+	/**
+	 * Added date of track, or fallback date if none
+	 */
+	auto addedAt(int row) const -> const std::string &;
+
+	/**
+	 * Any loaded track has an added date
+	 */
+	auto hasAddedAt() const -> bool;
+
+	/**
+	 * Key to sort track by in a text column, compared case-sensitively
+	 */
+	auto sortKey(int row, Column column) const -> const QString &;
+
+	void setPlayingTrack(const std::string &trackId);
+	void setTrackNumbers(bool enabled);
+
 	auto rowCount(const QModelIndex &parent) const -> int override;
 	auto rowCount() const -> int;
 
 	auto columnCount(const QModelIndex &parent) const -> int override;
 
 	auto data(const QModelIndex &index, int role) const -> QVariant override;
-	auto data(const QModelIndex &index) const -> QVariant;
-
-	auto parent(const QModelIndex &child) const -> QModelIndex override;
-
-protected:
-	auto roleNames() const -> QHash<int, QByteArray> override;
+	auto headerData(int section, Qt::Orientation orientation,
+		int role) const -> QVariant override;
+	auto flags(const QModelIndex &index) const -> Qt::ItemFlags override;
 
 private:
+	const lib::settings &settings;
+
 	std::vector<lib::spt::track> tracks;
+
+	/**
+	 * Sort keys of title, artist and album, in the same order as tracks
+	 */
+	std::vector<std::array<QString, 3>> sortKeys;
+	std::string fallbackAddedAt;
+
+	int playingRow = -1;
+	int fieldWidth = 1;
+	bool trackNumbers;
+
+	QIcon emptyIcon;
+	QIcon playingIcon;
+
+	void updateFieldWidth(int total);
+	void addSortKeys(const std::vector<lib::spt::track> &items);
+
+	static auto toSortKey(const std::string &str) -> QString;
+
+	auto displayText(const lib::spt::track &track, int row, Column column) const -> QString;
+	auto toolTip(const lib::spt::track &track, int row, Column column) const -> QString;
+	auto addedText(const std::string &date) const -> QString;
 };
@@ -0,0 +1,45 @@
+#include "model/tracklistproxymodel.hpp"
+
+TrackListProxyModel::TrackListProxyModel(TrackListModel *model, QObject *parent)
+	: QSortFilterProxyModel(parent),
+	model(model)
+{
+	setSourceModel(model);
+	setDynamicSortFilter(true);
+}
+
+auto TrackListProxyModel::sourceRow(int row) const -> int
+{
+	return mapToSource(index(row, 0)).row();
+}
+
+auto TrackListProxyModel::proxyRow(int sourceRow) const -> int
+{
+	return mapFromSource(model->index(sourceRow, 0)).row();
+}
+
+auto TrackListProxyModel::lessThan(const QModelIndex &left,
+	const QModelIndex &right) const -> bool
+{
+	const auto column = static_cast<Column>(left.column());
+
+	switch (column)
+	{
+		case Column::Index:
+			return left.row() < right.row();
+
+		case Column::Length:
+			return model->at(left.row()).duration < model->at(right.row()).duration;
+
+		case Column::Added:
+			// ISO dates can be compared as strings
+			return model->addedAt(left.row()) < model->addedAt(right.row());
+
+		case Column::Title:
+		case Column::Artist:
+		case Column::Album:
+			break;
+	}
+
+	return model->sortKey(left.row(), column) < model->sortKey(right.row(), column);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "model/tracklistmodel.hpp"
+
+#include <QSortFilterProxyModel>
+
+class TrackListProxyModel: public QSortFilterProxyModel
+{
+Q_OBJECT
+
+public:
+	TrackListProxyModel(TrackListModel *model, QObject *parent);
+
+	/**
+	 * Row in source model from row in this model
+	 */
+	auto sourceRow(int row) const -> int;
+
+	/**
+	 * Row in this model from row in source model
+	 */
+	auto proxyRow(int sourceRow) const -> int;
+
+protected:
+	auto lessThan(const QModelIndex &left, const QModelIndex &right) const -> bool override;
+
+private:
+	TrackListModel *model = nullptr;
+};
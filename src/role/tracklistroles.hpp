@@ -1,7 +0,0 @@
-#pragma once
-
-enum class TrackListRole
-{
-	Track,
-	Index,
-};
@@ -1,4 +1,5 @@
 #include "settingspage/application.hpp"
+#include "mainwindow.hpp"
 
 SettingsPage::Application::Application(lib::settings &settings, QWidget *parent)
 	: SettingsPage::Base(settings, parent)
@@ -44,6 +45,21 @@ auto SettingsPage::Application::app() -> QWidget *
 	comboBoxLayout->addWidget(appMaxQueue, 1, 1);
 	comboBoxLayout->addWidget(new QLabel("tracks", this), 1, 2);
 
+	// Album cover cache
+	auto *albumCacheLabel = new QLabel("Album cover cache", this);
+	albumCacheLabel->setToolTip("Maximum size of cached album covers, or 0 for unlimited");
+	comboBoxLayout->addWidget(albumCacheLabel, 2, 0);
+
+	appAlbumCache = new QComboBox(this);
+	appAlbumCache->setEditable(true);
+	appAlbumCache->setValidator(new QIntValidator(0, maxAlbumCache, this));
+	appAlbumCache->addItems({
+		"100", "250", "1000"
+	});
+	appAlbumCache->setCurrentText(QString::number(settings.general.album_cache_size));
+	comboBoxLayout->addWidget(appAlbumCache, 2, 1);
+	comboBoxLayout->addWidget(new QLabel("MB", this), 2, 2);
+
 	layout->addLayout(comboBoxLayout);
 
 	// MPRIS D-Bus
@@ -112,6 +128,26 @@ auto SettingsPage::Application::save() -> bool
 		settings.spotify.max_queue = maxQueue;
 	}
 
+	// Album cover cache
+	if (appAlbumCache != nullptr)
+	{
+		auto ok = false;
+		auto albumCache = appAlbumCache->currentText().toInt(&ok);
+		if (!ok || albumCache < 0 || albumCache > maxAlbumCache)
+		{
+			applyFail("album cover cache");
+			return false;
+		}
+		settings.general.album_cache_size = albumCache;
+
+		auto *mainWindow = MainWindow::find(parentWidget());
+		if (mainWindow != nullptr)
+		{
+			mainWindow->getAlbumCacheEvictor()
+				.set_max_size(MainWindow::albumCacheLimit(settings));
+		}
+	}
+
 	// Other application stuff
 	if (appWhatsNew != nullptr)
 	{
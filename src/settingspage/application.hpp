@@ -22,6 +22,7 @@ namespace SettingsPage
 		QCheckBox *appWhatsNew = nullptr;
 		QComboBox *appRefresh = nullptr;
 		QComboBox *appMaxQueue = nullptr;
+		QComboBox *appAlbumCache = nullptr;
 
 		static constexpr int minRefreshInterval = 1;
 		static constexpr int maxRefreshInterval = 60;
@@ -29,6 +30,8 @@ namespace SettingsPage
 		static constexpr int minMaxQueue = 1;
 		static constexpr int maxMaxQueue = 1000;
 
+		static constexpr int maxAlbumCache = 100000;
+
 		auto app() -> QWidget *;
 	};
 }
@@ -1,7 +1,7 @@
 #include "spotifyclient/runner.hpp"
 #include "mainwindow.hpp"
 
-std::vector<lib::log_message> SpotifyClient::Runner::log;
+lib::log_store SpotifyClient::Runner::log(lib::log::capacity);
 
 SpotifyClient::Runner::Runner(const lib::settings &settings,
 	const lib::paths &paths, QWidget *parent)
@@ -180,7 +180,7 @@ void SpotifyClient::Runner::logOutput(const QByteArray &output, lib::log_type lo
 			continue;
 		}
 
-		log.emplace_back(lib::date_time::now(), logType, line.toStdString());
+		log.add(lib::log_message(lib::date_time::now(), logType, line.toStdString()));
 	}
 }
 
@@ -194,7 +194,7 @@ void SpotifyClient::Runner::readyError() const
 	logOutput(process->readAllStandardError(), lib::log_type::error);
 }
 
-auto SpotifyClient::Runner::getLog() -> const std::vector<lib::log_message> &
+auto SpotifyClient::Runner::getLog() -> const lib::log_store &
 {
 	return log;
 }
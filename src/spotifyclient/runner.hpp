@@ -2,7 +2,7 @@
 
 #include "lib/enum/clienttype.hpp"
 #include "lib/settings.hpp"
-#include "lib/logmessage.hpp"
+#include "lib/log.hpp"
 
 #include "spotifyclient/helper.hpp"
 #include "keyring/kwallet.hpp"
@@ -30,14 +30,14 @@ namespace SpotifyClient
 		auto start() -> QString;
 		auto waitForStarted() const -> bool;
 
-		static auto getLog() -> const std::vector<lib::log_message> &;
+		static auto getLog() -> const lib::log_store &;
 		auto isRunning() const -> bool;
 
 	private:
 		QProcess *process = nullptr;
 		QWidget *parentWidget = nullptr;
 		QString path;
-		static std::vector<lib::log_message> log;
+		static lib::log_store log;
 		const lib::settings &settings;
 		const lib::paths &paths;
 		lib::client_type clientType;
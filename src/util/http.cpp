@@ -1,7 +1,11 @@
 #include "util/http.hpp"
 
-void Http::getAlbum(const std::string &url, const lib::http_client &httpClient,
-	lib::cache &cache, bool useDefaultIcon, lib::callback<QPixmap> &callback)
+#include <memory>
+
+#include <QPointer>
+
+void Http::getAlbum(const std::string &url, lib::image_loader &imageLoader,
+	bool useDefaultIcon, lib::callback<QPixmap> &callback)
 {
 	if (url.empty())
 	{
@@ -9,47 +13,100 @@ void Http::getAlbum(const std::string &url, const lib::http_client &httpClient,
 		return;
 	}
 
-	auto data = cache.get_album_image(url);
-	if (lib::image::is_jpeg(data))
+	QPixmap pixmap;
+	if (PixmapCache::find(url, QSize(), QString(), pixmap))
 	{
-		QPixmap img;
-		img.loadFromData(data.data(), static_cast<unsigned int>(data.size()), "jpeg");
-		callback(img);
+		callback(pixmap);
 		return;
 	}
 
-	if (useDefaultIcon)
+	// Cached images are loaded before returning
+	auto loaded = std::make_shared<bool>(false);
+
+	imageLoader.get(url,
+		[url, callback, loaded](const std::vector<unsigned char> &data)
+		{
+			*loaded = true;
+			if (data.empty())
+			{
+				return;
+			}
+
+			const auto pixmap = toPixmap(data);
+			PixmapCache::insert(url, QSize(), QString(), pixmap);
+			callback(pixmap);
+		});
+
+	if (useDefaultIcon && !*loaded)
 	{
 		callback(defaultIcon());
 	}
+}
+
+void Http::getAlbum(const std::string &url, lib::image_loader &imageLoader,
+	lib::callback<QPixmap> &callback)
+{
+	getAlbum(url, imageLoader, true, callback);
+}
 
-	httpClient.get(url, lib::headers(),
-		[&cache, url, callback](const std::string &str)
+void Http::getAlbum(const std::string &url, lib::image_loader &imageLoader,
+	const QSize &size, QObject *context, lib::callback<QPixmap> &callback)
+{
+	if (url.empty())
+	{
+		callback(QPixmap());
+		return;
+	}
+
+	QPixmap pixmap;
+	if (PixmapCache::find(url, size, QString(), pixmap))
+	{
+		callback(pixmap);
+		return;
+	}
+
+	// Cached images are loaded before returning, and only need decoding
+	auto loaded = std::make_shared<bool>(false);
+
+	QPointer<QObject> receiver(context);
+	imageLoader.get(url,
+		[url, size, receiver, callback, loaded](const std::vector<unsigned char> &data)
 		{
-			auto data = QByteArray::fromStdString(str);
-			if (!lib::image::is_jpeg(std::vector<unsigned char>(data.begin(), data.end())))
+			*loaded = true;
+			if (data.empty() || receiver.isNull())
 			{
-				lib::log::warn("Album art from \"{}\" is not a valid JPEG image",
-					url);
 				return;
 			}
-			cache.set_album_image(url,
-				std::vector<unsigned char>(data.begin(), data.end()));
 
-			QPixmap img;
-			img.loadFromData(data, "jpeg");
-			callback(img);
+			ImagePipeline::decode(data, size, receiver.data(),
+				[url, size, callback](const QImage &image)
+				{
+					if (image.isNull())
+					{
+						return;
+					}
+
+					const auto pixmap = QPixmap::fromImage(image);
+					PixmapCache::insert(url, size, QString(), pixmap);
+					callback(pixmap);
+				});
 		});
+
+	// Only show default icon while downloading
+	if (!*loaded)
+	{
+		callback(defaultIcon());
+	}
 }
 
-void Http::getAlbum(const std::string &url, const lib::http_client &httpClient,
-	lib::cache &cache, lib::callback<QPixmap> &callback)
+auto Http::toPixmap(const std::vector<unsigned char> &data) -> QPixmap
 {
-	getAlbum(url, httpClient, cache, true, callback);
+	QPixmap img;
+	img.loadFromData(data.data(), static_cast<unsigned int>(data.size()), "jpeg");
+	return img;
 }
 
 auto Http::defaultIcon() -> QPixmap
 {
-	constexpr int iconSize = 64;
 	return Icon::get("media-optical-audio").pixmap(iconSize);
 }
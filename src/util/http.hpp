@@ -1,10 +1,11 @@
 #pragma once
 
 #include "lib/spotify/callback.hpp"
-#include "lib/cache.hpp"
-#include "lib/httpclient.hpp"
 #include "lib/image.hpp"
+#include "lib/imageloader.hpp"
 #include "util/icon.hpp"
+#include "util/imagepipeline.hpp"
+#include "util/pixmapcache.hpp"
 
 #include <string>
 #include <QPixmap>
@@ -15,22 +16,42 @@ public:
 	/**
 	 * Get album from cache or from HTTP
 	 * @param url URL to get album from
-	 * @param httpClient HTTP client to use
-	 * @param cache Cache instance to album cache
+	 * @param imageLoader Loader to get album from cache, or download it with
 	 * @param useDefaultIcon If no cache, call callback first with default icon
 	 * @param callback Callback to call one or more times
 	 */
-	static void getAlbum(const std::string &url, const lib::http_client &httpClient,
-		lib::cache &cache, bool useDefaultIcon, lib::callback<QPixmap> &callback);
+	static void getAlbum(const std::string &url, lib::image_loader &imageLoader,
+		bool useDefaultIcon, lib::callback<QPixmap> &callback);
 
 	/**
 	 * Get album from cache or from HTTP, using default icon
 	 */
-	static void getAlbum(const std::string &url, const lib::http_client &httpClient,
-		lib::cache &cache, lib::callback<QPixmap> &callback);
+	static void getAlbum(const std::string &url, lib::image_loader &imageLoader,
+		lib::callback<QPixmap> &callback);
+
+	/**
+	 * Get album from cache or from HTTP, using default icon while downloading,
+	 * and decode and scale it on a worker thread
+	 * @param size Size to scale image to
+	 * @param context Callback isn't called if destroyed before image is loaded
+	 */
+	static void getAlbum(const std::string &url, lib::image_loader &imageLoader,
+		const QSize &size, QObject *context, lib::callback<QPixmap> &callback);
+
+	/**
+	 * Size of album images shown as icons
+	 */
+	static constexpr int iconSize = 64;
+
+	/**
+	 * Maximum number of images downloaded at once from the same host
+	 */
+	static constexpr size_t maxRequestsPerHost = 6;
 
 private:
 	Http() = default;
 
+	static auto toPixmap(const std::vector<unsigned char> &data) -> QPixmap;
+
 	static auto defaultIcon() -> QPixmap;
 };
@@ -0,0 +1,83 @@
+#include "util/imagepipeline.hpp"
+
+#include <QMetaObject>
+
+ImagePipeline::ImagePipeline(std::function<void(const QImage &)> callback, QObject *parent)
+	: QObject(parent),
+	state(std::make_shared<State>()),
+	callback(std::move(callback))
+{
+}
+
+ImagePipeline::~ImagePipeline()
+{
+	// Worker can't deliver to this object after it's destroyed
+	std::lock_guard<std::mutex> lock(state->mutex);
+	state->cancelled = true;
+}
+
+void ImagePipeline::decode(const std::vector<unsigned char> &data, const QSize &size,
+	QObject *context, const std::function<void(const QImage &)> &callback)
+{
+	// Destroyed with context, cancelling the request
+	auto *receiver = new ImagePipeline(callback, context);
+	threadPool()->start(new Task(data, size, receiver->state, receiver));
+}
+
+auto ImagePipeline::threadPool() -> QThreadPool *
+{
+	static QThreadPool pool;
+	if (pool.maxThreadCount() > 2)
+	{
+		// Leave cores for the GUI, and keep decoded images in memory low
+		pool.setMaxThreadCount(2);
+	}
+	return &pool;
+}
+
+void ImagePipeline::deliver(const QImage &image)
+{
+	callback(image);
+	deleteLater();
+}
+
+//region Task
+
+ImagePipeline::Task::Task(std::vector<unsigned char> data, const QSize &size,
+	std::shared_ptr<State> state, ImagePipeline *receiver)
+	: data(std::move(data)),
+	size(size),
+	state(std::move(state)),
+	receiver(receiver)
+{
+}
+
+auto ImagePipeline::Task::isCancelled() const -> bool
+{
+	std::lock_guard<std::mutex> lock(state->mutex);
+	return state->cancelled;
+}
+
+void ImagePipeline::Task::run()
+{
+	if (isCancelled())
+	{
+		return;
+	}
+
+	auto image = QImage::fromData(data.data(), static_cast<int>(data.size()), "jpeg");
+	if (!image.isNull() && size.isValid())
+	{
+		image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+	}
+
+	// Held while queueing, so receiver isn't destroyed meanwhile
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if (!state->cancelled)
+	{
+		QMetaObject::invokeMethod(receiver, "deliver",
+			Qt::QueuedConnection, Q_ARG(QImage, image));
+	}
+}
+
+//endregion
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QImage>
+#include <QObject>
+#include <QRunnable>
+#include <QSize>
+#include <QThreadPool>
+
+/**
+ * Decodes and scales images on worker threads
+ */
+class ImagePipeline: public QObject
+{
+Q_OBJECT
+
+public:
+	/**
+	 * Decode, and optionally scale, JPEG image on a worker thread
+	 * @param data JPEG image data
+	 * @param size Size to scale to, keeping aspect ratio, or invalid size for original size
+	 * @param context Callback isn't called if destroyed before image is decoded
+	 * @param callback Decoded image, called on the thread of context
+	 */
+	static void decode(const std::vector<unsigned char> &data, const QSize &size,
+		QObject *context, const std::function<void(const QImage &)> &callback);
+
+private:
+	/**
+	 * State shared with worker thread
+	 */
+	struct State
+	{
+		std::mutex mutex;
+		bool cancelled = false;
+	};
+
+	class Task: public QRunnable
+	{
+	public:
+		Task(std::vector<unsigned char> data, const QSize &size,
+			std::shared_ptr<State> state, ImagePipeline *receiver);
+
+		void run() override;
+
+	private:
+		std::vector<unsigned char> data;
+		QSize size;
+		std::shared_ptr<State> state;
+		ImagePipeline *receiver;
+
+		auto isCancelled() const -> bool;
+	};
+
+	ImagePipeline(std::function<void(const QImage &)> callback, QObject *parent);
+	~ImagePipeline() override;
+
+	std::shared_ptr<State> state;
+	std::function<void(const QImage &)> callback;
+
+	static auto threadPool() -> QThreadPool *;
+
+	Q_INVOKABLE void deliver(const QImage &image);
+};
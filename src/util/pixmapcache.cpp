@@ -0,0 +1,55 @@
+#include "util/pixmapcache.hpp"
+
+auto PixmapCache::find(const std::string &url, const QSize &size,
+	const QString &variant, QPixmap &pixmap) -> bool
+{
+	if (url.empty())
+	{
+		return false;
+	}
+
+	return QPixmapCache::find(key(url, size, variant), &pixmap);
+}
+
+void PixmapCache::insert(const std::string &url, const QSize &size,
+	const QString &variant, const QPixmap &pixmap)
+{
+	if (url.empty() || pixmap.isNull())
+	{
+		return;
+	}
+
+	if (QPixmapCache::cacheLimit() < cacheLimit)
+	{
+		QPixmapCache::setCacheLimit(cacheLimit);
+	}
+
+	QPixmapCache::insert(key(url, size, variant), pixmap);
+}
+
+auto PixmapCache::scaled(const std::string &url, const QString &variant,
+	const QPixmap &source, const QSize &size, Qt::AspectRatioMode mode) -> QPixmap
+{
+	// Saved without size, to replace the previous size when resized
+	const auto scaledVariant = QStringLiteral("scaled-%1").arg(variant);
+
+	QPixmap pixmap;
+	if (find(url, QSize(), scaledVariant, pixmap)
+		&& pixmap.size() == source.size().scaled(size, mode))
+	{
+		return pixmap;
+	}
+
+	pixmap = source.scaled(size, mode);
+	insert(url, QSize(), scaledVariant, pixmap);
+	return pixmap;
+}
+
+auto PixmapCache::key(const std::string &url, const QSize &size,
+	const QString &variant) -> QString
+{
+	return QString("%1:%2:%3x%4")
+		.arg(variant, QString::fromStdString(url))
+		.arg(size.width())
+		.arg(size.height());
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+
+#include <QPixmap>
+#include <QPixmapCache>
+#include <QSize>
+#include <QString>
+
+/**
+ * Decoded, and optionally scaled, images kept in memory
+ */
+class PixmapCache
+{
+public:
+	/**
+	 * Find image
+	 * @param url URL image was loaded from
+	 * @param size Scaled size, or invalid size for original size
+	 * @param variant Variant of image, for example if masked
+	 * @param pixmap Image, if found
+	 * @return Image was found
+	 */
+	static auto find(const std::string &url, const QSize &size,
+		const QString &variant, QPixmap &pixmap) -> bool;
+
+	/**
+	 * Save image
+	 */
+	static void insert(const std::string &url, const QSize &size,
+		const QString &variant, const QPixmap &pixmap);
+
+	/**
+	 * Get scaled image from cache, or scale and save it,
+	 * only keeping the last requested size of each image
+	 */
+	static auto scaled(const std::string &url, const QString &variant,
+		const QPixmap &source, const QSize &size, Qt::AspectRatioMode mode) -> QPixmap;
+
+private:
+	PixmapCache() = default;
+
+	/**
+	 * Size of cache in KiB
+	 */
+	static constexpr int cacheLimit = 32 * 1024;
+
+	static auto key(const std::string &url, const QSize &size,
+		const QString &variant) -> QString;
+};
@@ -2,11 +2,11 @@
 #include "mainwindow.hpp"
 
 Artist::AlbumsList::AlbumsList(lib::spt::api &spotify, lib::cache &cache,
-	const lib::http_client &httpClient, QWidget *parent)
+	lib::image_loader &imageLoader, QWidget *parent)
 	: QTreeWidget(parent),
 	spotify(spotify),
 	cache(cache),
-	httpClient(httpClient)
+	imageLoader(imageLoader)
 {
 	setEnabled(false);
 	setColumnCount(2);
@@ -57,13 +57,14 @@ void Artist::AlbumsList::setAlbums(const std::vector<lib::spt::album> &albums)
 			albumName, year.isEmpty() ? QString() : year
 		});
 
-		Http::getAlbum(album.image, httpClient, cache, [item](const QPixmap &image)
-		{
-			if (item != nullptr)
+		Http::getAlbum(album.image, imageLoader, QSize(Http::iconSize, Http::iconSize),
+			this, [item](const QPixmap &image)
 			{
-				item->setIcon(0, QIcon(image));
-			}
-		});
+				if (item != nullptr)
+				{
+					item->setIcon(0, QIcon(image));
+				}
+			});
 
 		item->setData(0, static_cast<int>(DataRole::AlbumId),
 			QString::fromStdString(album.id));
@@ -2,6 +2,7 @@
 
 #include "lib/spotify/api.hpp"
 #include "lib/cache.hpp"
+#include "lib/imageloader.hpp"
 #include "lib/enum/albumgroup.hpp"
 
 #include <QTreeWidget>
@@ -15,14 +16,14 @@ namespace Artist
 	{
 	public:
 		AlbumsList(lib::spt::api &spotify, lib::cache &cache,
-			const lib::http_client &httpClient, QWidget *parent);
+			lib::image_loader &imageLoader, QWidget *parent);
 
 		void setAlbums(const std::vector<lib::spt::album> &albums);
 
 	private:
 		lib::spt::api &spotify;
 		lib::cache &cache;
-		const lib::http_client &httpClient;
+		lib::image_loader &imageLoader;
 
 		std::map<lib::album_group, QTreeWidgetItem *> groups;
 
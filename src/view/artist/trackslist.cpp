@@ -2,11 +2,11 @@
 #include "mainwindow.hpp"
 
 Artist::TracksList::TracksList(lib::spt::api &spotify, lib::cache &cache,
-	const lib::http_client &httpClient, const lib::spt::artist &artist, QWidget *parent)
+	lib::image_loader &imageLoader, const lib::spt::artist &artist, QWidget *parent)
 	: QListWidget(parent),
 	spotify(spotify),
 	cache(cache),
-	httpClient(httpClient),
+	imageLoader(imageLoader),
 	artist(artist)
 {
 	setEnabled(false);
@@ -28,13 +28,14 @@ void Artist::TracksList::addTrack(const lib::spt::track &track)
 	auto *item = new QListWidgetItem(QString::fromStdString(track.name), this);
 	item->setData(static_cast<int>(DataRole::Track), QVariant::fromValue(track));
 
-	Http::getAlbum(track.image_small(), httpClient, cache, [item](const QPixmap &image)
-	{
-		if (item != nullptr)
+	Http::getAlbum(track.image_small(), imageLoader, QSize(Http::iconSize, Http::iconSize),
+		this, [item](const QPixmap &image)
 		{
-			item->setIcon(QIcon(image));
-		}
-	});
+			if (item != nullptr)
+			{
+				item->setIcon(QIcon(image));
+			}
+		});
 }
 
 void Artist::TracksList::onDoubleClicked(QListWidgetItem *currentItem)
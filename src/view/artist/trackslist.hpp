@@ -13,7 +13,7 @@ namespace Artist
 	{
 	public:
 		TracksList(lib::spt::api &spotify, lib::cache &cache,
-			const lib::http_client &httpClient, const lib::spt::artist &artist,
+			lib::image_loader &imageLoader, const lib::spt::artist &artist,
 			QWidget *parent);
 
 		void addTrack(const lib::spt::track &track);
@@ -21,7 +21,7 @@ namespace Artist
 	private:
 		lib::spt::api &spotify;
 		lib::cache &cache;
-		const lib::http_client &httpClient;
+		lib::image_loader &imageLoader;
 		const lib::spt::artist &artist;
 
 		void onDoubleClicked(QListWidgetItem *currentItem);
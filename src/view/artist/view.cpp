@@ -2,12 +2,14 @@
 #include "mainwindow.hpp"
 
 Artist::View::View(lib::spt::api &spotify, const std::string &artistId,
-	lib::cache &cache, const lib::http_client &httpClient, QWidget *parent)
+	lib::cache &cache, const lib::http_client &httpClient,
+	lib::image_loader &imageLoader, QWidget *parent)
 	: QWidget(parent),
 	artistId(std::string(artistId)),
 	spotify(spotify),
 	cache(cache),
-	httpClient(httpClient)
+	httpClient(httpClient),
+	imageLoader(imageLoader)
 {
 	layout = new QVBoxLayout();
 	layout->setContentsMargins(-1, 0, -1, 0);
@@ -39,11 +41,11 @@ Artist::View::View(lib::spt::api &spotify, const std::string &artistId,
 
 	// Top tracks
 	topTracksList = new Artist::TracksList(spotify, cache,
-		httpClient, artist, tabs);
+		imageLoader, artist, tabs);
 	tabs->addTab(topTracksList, "Popular");
 
 	// Albums
-	albumList = new Artist::AlbumsList(spotify, cache, httpClient, this);
+	albumList = new Artist::AlbumsList(spotify, cache, imageLoader, this);
 	tabs->addTab(albumList, "Discography");
 
 	// Related artists
@@ -31,7 +31,8 @@ namespace Artist
 
 	public:
 		View(lib::spt::api &spotify, const std::string &artistId,
-			lib::cache &cache, const lib::http_client &httpClient, QWidget *parent);
+			lib::cache &cache, const lib::http_client &httpClient,
+			lib::image_loader &imageLoader, QWidget *parent);
 
 	private:
 		void artistLoaded(const lib::spt::artist &loadedArtist);
@@ -45,6 +46,7 @@ namespace Artist
 		lib::spt::api &spotify;
 		lib::cache &cache;
 		const lib::http_client &httpClient;
+		lib::image_loader &imageLoader;
 
 		AlbumsList *albumList;
 		Cover *coverLabel = nullptr;
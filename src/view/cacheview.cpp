@@ -1,5 +1,6 @@
 #include "view/cacheview.hpp"
 #include "lib/format.hpp"
+#include "mainwindow.hpp"
 
 CacheView::CacheView(const lib::paths &paths, QWidget *parent)
 	: QTreeWidget(parent),
@@ -57,7 +58,7 @@ auto CacheView::fullName(const QString &folderName) -> QString
 	return folderName;
 }
 
-void CacheView::folderSize(const QString &path, unsigned int *count, unsigned int *size)
+void CacheView::folderSize(const QString &path, unsigned int *count, size_t *size)
 {
 	for (auto &file: QDir(path).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::Files))
 	{
@@ -102,7 +103,7 @@ void CacheView::reload()
 		item->setText(0, fullName(dir.baseName()));
 
 		auto count = 0U;
-		auto size = 0U;
+		size_t size = 0;
 		folderSize(dir.absoluteFilePath(), &count, &size);
 
 		item->setData(0, 0x100, dir.absoluteFilePath());
@@ -110,9 +111,43 @@ void CacheView::reload()
 		item->setText(2, QString::fromStdString(lib::format::size(size)));
 	}
 
+	addAlbumCacheItems();
+
 	header()->resizeSections(QHeaderView::ResizeToContents);
 }
 
+void CacheView::addAlbumCacheItems()
+{
+	auto *mainWindow = MainWindow::find(parentWidget());
+	if (mainWindow == nullptr)
+	{
+		return;
+	}
+
+	const auto &evictor = mainWindow->getAlbumCacheEvictor();
+	const auto stats = evictor.get_stats();
+	const auto maxSize = evictor.get_max_size();
+
+	auto *limitItem = new QTreeWidgetItem(this);
+	limitItem->setText(0, QStringLiteral("Album cover limit"));
+	limitItem->setToolTip(0, QStringLiteral("Size of album covers, "
+		"from last check, out of maximum size"));
+	limitItem->setText(1, QString::number(stats.files));
+	limitItem->setText(2, QStringLiteral("%1 / %2")
+		.arg(QString::fromStdString(lib::format::size(stats.size)),
+			maxSize > 0
+				? QString::fromStdString(lib::format::size(maxSize))
+				: QStringLiteral("unlimited")));
+
+	auto *evictedItem = new QTreeWidgetItem(this);
+	evictedItem->setText(0, QStringLiteral("Removed album covers"));
+	evictedItem->setToolTip(0, QStringLiteral("Least recently used album covers removed "
+		"to keep cache within limit, since the application was started"));
+	evictedItem->setText(1, QString::number(stats.evicted_files));
+	evictedItem->setText(2,
+		QString::fromStdString(lib::format::size(stats.evicted_bytes)));
+}
+
 void CacheView::showEvent(QShowEvent */*event*/)
 {
 	reload();
@@ -17,8 +17,9 @@ private:
 	const lib::paths &paths;
 
 	static auto fullName(const QString &folderName) -> QString;
-	static void folderSize(const QString &path, unsigned int *count, unsigned int *size);
+	static void folderSize(const QString &path, unsigned int *count, size_t *size);
 	void menu(const QPoint &pos);
 	void reload();
+	void addAlbumCacheItems();
 	void showEvent(QShowEvent *event) override;
 };
@@ -14,11 +14,33 @@ auto Context::AbstractContent::getCurrentlyPlaying() const -> const lib::spt::tr
 	return currentlyPlaying;
 }
 
-void Context::AbstractContent::setAlbum(const lib::spt::entity &albumEntity, const QPixmap &albumImage)
+void Context::AbstractContent::setAlbum(const lib::spt::entity &albumEntity,
+	const std::string &albumImageUrl, const QPixmap &albumImage)
 {
 	if (album != nullptr)
 	{
-		album->setPixmap(Image::mask(albumImage));
+		// Placeholder icon shown while loading shouldn't be cached as the cover
+		QPixmap decoded;
+		const auto isCover = PixmapCache::find(albumImageUrl, QSize(), QString(), decoded)
+			&& decoded.cacheKey() == albumImage.cacheKey();
+
+		if (!isCover)
+		{
+			album->setPixmap(Image::mask(albumImage));
+		}
+		else
+		{
+			const auto variant = QStringLiteral("mask");
+			QPixmap masked;
+
+			if (!PixmapCache::find(albumImageUrl, QSize(), variant, masked))
+			{
+				masked = Image::mask(albumImage);
+				PixmapCache::insert(albumImageUrl, QSize(), variant, masked);
+			}
+
+			album->setPixmap(masked, albumImageUrl);
+		}
 		album->setToolTip(QString::fromStdString(albumEntity.name));
 	}
 }
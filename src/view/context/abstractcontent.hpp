@@ -34,7 +34,8 @@ namespace Context
 
 		void setCurrentlyPlaying(const lib::spt::track &track);
 
-		void setAlbum(const lib::spt::entity &albumEntity, const QPixmap &albumImage);
+		void setAlbum(const lib::spt::entity &albumEntity, const std::string &albumImageUrl,
+			const QPixmap &albumImage);
 
 		virtual ~AbstractContent() {};
 
@@ -8,12 +8,22 @@ Context::AlbumCover::AlbumCover(QWidget *parent)
 
 void Context::AlbumCover::setPixmap(const QPixmap &pixmap)
 {
-	cover = pixmap.copy();
+	setPixmap(pixmap, std::string());
+}
+
+void Context::AlbumCover::setPixmap(const QPixmap &pixmap, const std::string &coverUrl)
+{
+	cover = pixmap;
+	url = coverUrl;
 	scaleCover(width(), width());
 }
 
 void Context::AlbumCover::scaleCover(int width, int height)
 {
-	auto pixmap = cover.scaled(width, height, Qt::KeepAspectRatioByExpanding);
-	QLabel::setPixmap(pixmap);
+	const QSize size(width, height);
+
+	QLabel::setPixmap(url.empty()
+		? cover.scaled(size, Qt::KeepAspectRatioByExpanding)
+		: PixmapCache::scaled(url, QStringLiteral("cover"), cover,
+			size, Qt::KeepAspectRatioByExpanding));
 }
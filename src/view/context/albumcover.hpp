@@ -1,6 +1,7 @@
 #pragma once
 
 #include "lib/log.hpp"
+#include "util/pixmapcache.hpp"
 
 #include <QLabel>
 #include <QResizeEvent>
@@ -14,9 +15,15 @@ namespace Context
 
 		void setPixmap(const QPixmap &pixmap);
 
+		/**
+		 * Set cover, where scaled versions are cached by URL
+		 */
+		void setPixmap(const QPixmap &pixmap, const std::string &url);
+
 		void scaleCover(int width, int height);
 
 	private:
 		QPixmap cover;
+		std::string url;
 	};
 }
@@ -55,7 +55,8 @@ void Context::View::setCurrentlyPlaying(const lib::spt::track &track) const
 	albumContent->setCurrentlyPlaying(track);
 }
 
-void Context::View::setAlbum(const lib::spt::entity &albumEntity, const QPixmap &albumImage) const
+void Context::View::setAlbum(const lib::spt::entity &albumEntity,
+	const std::string &albumImageUrl, const QPixmap &albumImage) const
 {
-	albumContent->setAlbum(albumEntity, albumImage);
+	albumContent->setAlbum(albumEntity, albumImageUrl, albumImage);
 }
@@ -24,7 +24,8 @@ namespace Context
 		auto getCurrentlyPlaying() const -> const lib::spt::track &;
 		void setCurrentlyPlaying(const lib::spt::track &track) const;
 
-		void setAlbum(const lib::spt::entity &albumEntity, const QPixmap &albumImage) const;
+		void setAlbum(const lib::spt::entity &albumEntity, const std::string &albumImageUrl,
+			const QPixmap &albumImage) const;
 		void reloadAlbumContent(bool shouldBeExpandable);
 
 	private:
@@ -6,7 +6,7 @@ Log::Application::Application(QWidget *parent)
 {
 }
 
-auto Log::Application::getMessages() -> const std::vector<lib::log_message> &
+auto Log::Application::getStore() -> const lib::log_store &
 {
-	return lib::log::get_messages();
+	return lib::log::get_store();
 }
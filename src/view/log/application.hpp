@@ -10,6 +10,6 @@ namespace Log
 		Application(QWidget *parent);
 
 	protected:
-		auto getMessages() -> const std::vector<lib::log_message> & override;
+		auto getStore() -> const lib::log_store & override;
 	};
 }
@@ -11,6 +11,8 @@
 #include <QFileDialog>
 #include <QMenu>
 
+#include <algorithm>
+
 Log::Base::Base(QWidget *parent)
 	: QWidget(parent)
 {
@@ -53,26 +55,68 @@ void Log::Base::showEvent(QShowEvent *event)
 {
 	QWidget::showEvent(event);
 
-	list->clear();
-	for (const auto &logMessage: getMessages())
+	std::vector<lib::log_store::entry> entries;
+	const auto result = getStore().read(cursor, entries);
+
+	removeItems(result);
+
+	for (const auto &entry: entries)
 	{
-		const auto time = QString::fromStdString(logMessage.get_time());
-		const auto type = QString::fromStdString(logMessage.get_type());
-		const auto message = QString::fromStdString(logMessage.get_message());
-
-		auto *item = new QTreeWidgetItem({
-			time,
-			type,
-			message,
-		});
-
-		item->setToolTip(0, time);
-		item->setToolTip(1, type);
-		item->setToolTip(2, message);
-
-		item->setData(0, messageRole, QVariant::fromValue(logMessage));
-		list->addTopLevelItem(item);
+		addItem(entry);
 	}
+
+	cursor = result.cursor;
+}
+
+void Log::Base::removeItems(const lib::log_store::read_result &result)
+{
+	// Removed messages are the oldest of their type, so newer messages are all kept
+	const auto keptFrom = *std::max_element(result.oldest.cbegin(), result.oldest.cend());
+
+	auto index = 0;
+	while (index < list->topLevelItemCount())
+	{
+		auto *item = list->topLevelItem(index);
+		const auto sequence = static_cast<size_t>(item->data(0, sequenceRole).toULongLong());
+		if (sequence >= keptFrom)
+		{
+			break;
+		}
+
+		const auto &data = item->data(0, messageRole);
+		const auto &message = data.value<lib::log_message>();
+
+		if (result.is_kept(sequence, message.get_log_type()))
+		{
+			index++;
+			continue;
+		}
+
+		delete list->takeTopLevelItem(index);
+	}
+}
+
+void Log::Base::addItem(const lib::log_store::entry &entry)
+{
+	const auto &logMessage = entry.message;
+
+	const auto time = QString::fromStdString(logMessage.get_time());
+	const auto type = QString::fromStdString(logMessage.get_type());
+	const auto message = QString::fromStdString(logMessage.get_message());
+
+	auto *item = new QTreeWidgetItem({
+		time,
+		type,
+		message,
+	});
+
+	item->setToolTip(0, time);
+	item->setToolTip(1, type);
+	item->setToolTip(2, message);
+
+	item->setData(0, messageRole, QVariant::fromValue(logMessage));
+	item->setData(0, sequenceRole, QVariant::fromValue<qulonglong>(entry.sequence));
+	list->addTopLevelItem(item);
 }
 
 auto Log::Base::collectLogs() -> QString
@@ -1,5 +1,5 @@
 #pragma once
-#include "lib/logmessage.hpp"
+#include "lib/logstore.hpp"
 
 #include <QWidget>
 #include <QTreeWidget>
@@ -11,15 +11,28 @@ namespace Log
 	protected:
 		explicit Base(QWidget *parent);
 
-		virtual auto getMessages() -> const std::vector<lib::log_message> & = 0;
+		virtual auto getStore() -> const lib::log_store & = 0;
 
 		void showEvent(QShowEvent *event) override;
 
 	private:
 		static constexpr int messageRole = 0x100;
+		static constexpr int sequenceRole = 0x101;
 
 		QTreeWidget *list;
 
+		/**
+		 * Cursor of next message to add to list
+		 */
+		size_t cursor = 0;
+
+		/**
+		 * Remove messages no longer kept in store
+		 */
+		void removeItems(const lib::log_store::read_result &result);
+
+		void addItem(const lib::log_store::entry &entry);
+
 		auto collectLogs() -> QString;
 
 		void onCopyToClipboard(bool checked);
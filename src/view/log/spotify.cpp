@@ -6,7 +6,7 @@ Log::Spotify::Spotify(QWidget *parent)
 {
 }
 
-auto Log::Spotify::getMessages() -> const std::vector<lib::log_message> &
+auto Log::Spotify::getStore() -> const lib::log_store &
 {
 	return SpotifyClient::Runner::getLog();
 }
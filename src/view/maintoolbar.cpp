@@ -2,7 +2,8 @@
 #include "mainwindow.hpp"
 
 MainToolBar::MainToolBar(lib::spt::api &spotify, lib::settings &settings,
-	const lib::http_client &httpClient, lib::cache &cache, QWidget *parent)
+	const lib::http_client &httpClient, lib::image_loader &imageLoader,
+	lib::cache &cache, QWidget *parent)
 	: QToolBar("Media controls", parent),
 	spotify(spotify),
 	settings(settings)
@@ -20,7 +21,7 @@ MainToolBar::MainToolBar(lib::spt::api &spotify, lib::settings &settings,
 	menu->setIcon(Icon::get("application-menu"));
 	menu->setPopupMode(QToolButton::InstantPopup);
 	menu->setMenu(new MainMenu(spotify, settings,
-		httpClient, cache, mainWindow));
+		httpClient, imageLoader, cache, mainWindow));
 
 	// Search
 	search = addAction(Icon::get("edit-find"), "Search");
@@ -18,7 +18,8 @@ Q_OBJECT
 
 public:
 	MainToolBar(lib::spt::api &spotify, lib::settings &settings,
-		const lib::http_client &httpClient, lib::cache &cache, QWidget *parent);
+		const lib::http_client &httpClient, lib::image_loader &imageLoader,
+		lib::cache &cache, QWidget *parent);
 
 	void showTitleBarButtons(bool show);
 	void setPlaying(bool playing);
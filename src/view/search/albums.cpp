@@ -2,11 +2,11 @@
 #include "mainwindow.hpp"
 
 Search::Albums::Albums(lib::spt::api &spotify, lib::cache &cache,
-	const lib::http_client &httpClient, QWidget *parent)
+	lib::image_loader &imageLoader, QWidget *parent)
 	: Search::SearchTabTree({"Title", "Artist"}, parent),
 	spotify(spotify),
 	cache(cache),
-	httpClient(httpClient)
+	imageLoader(imageLoader)
 {
 	QTreeWidget::connect(this, &QTreeWidget::itemClicked,
 		this, &Search::Albums::onItemClicked);
@@ -26,13 +26,14 @@ void Search::Albums::add(const lib::spt::album &album)
 		name, artist
 	});
 
-	Http::getAlbum(album.image, httpClient, cache, [item](const QPixmap &image)
-	{
-		if (item != nullptr)
+	Http::getAlbum(album.image, imageLoader, QSize(Http::iconSize, Http::iconSize),
+		this, [item](const QPixmap &image)
 		{
-			item->setIcon(0, image);
-		}
-	});
+			if (item != nullptr)
+			{
+				item->setIcon(0, image);
+			}
+		});
 
 	item->setData(0, static_cast<int>(DataRole::AlbumId), id);
 	item->setToolTip(0, name);
@@ -2,6 +2,7 @@
 
 #include "lib/spotify/api.hpp"
 #include "lib/cache.hpp"
+#include "lib/imageloader.hpp"
 #include "view/search/searchtabtree.hpp"
 
 namespace Search
@@ -12,14 +13,14 @@ namespace Search
 
 	public:
 		Albums(lib::spt::api &spotify, lib::cache &cache,
-			const lib::http_client &httpClient, QWidget *parent);
+			lib::image_loader &imageLoader, QWidget *parent);
 
 		void add(const lib::spt::album &album);
 
 	private:
 		lib::spt::api &spotify;
 		lib::cache &cache;
-		const lib::http_client &httpClient;
+		lib::image_loader &imageLoader;
 
 		void onItemClicked(QTreeWidgetItem *item, int column);
 		void onContextMenu(const QPoint &pos);
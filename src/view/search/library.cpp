@@ -1,12 +1,49 @@
 #include "view/search/library.hpp"
 #include "view/search/view.hpp"
 
+#include <QPointer>
+
 Search::Library::Library(lib::spt::api &spotify,
 	lib::cache &cache, QWidget *parent)
 	: Search::Tracks(spotify, cache, parent),
 	spotify(spotify),
 	cache(cache)
 {
+	auto *memoryCache = dynamic_cast<lib::memory_cache *>(&cache);
+	if (memoryCache == nullptr)
+	{
+		return;
+	}
+
+	// Cache is changed from the main thread
+	QPointer<Search::Library> library(this);
+
+	memoryCache->on_playlists_changed([library](const std::vector<lib::spt::playlist> &playlists)
+	{
+		if (library != nullptr)
+		{
+			library->onPlaylistsChanged(playlists);
+		}
+	});
+
+	memoryCache->on_playlist_changed([library](const lib::spt::playlist &playlist)
+	{
+		if (library != nullptr)
+		{
+			library->onPlaylistChanged(playlist);
+		}
+	});
+
+	memoryCache->on_tracks_changed([library](const std::string &entityId,
+		const std::vector<lib::spt::track> &tracks)
+	{
+		if (library != nullptr)
+		{
+			library->onTracksChanged(entityId, tracks);
+		}
+	});
+
+	watchingCache = true;
 }
 
 void Search::Library::searchCache(const std::string &query)
@@ -17,7 +54,14 @@ void Search::Library::searchCache(const std::string &query)
 		return;
 	}
 
-	addResults(query, cache.get_tracks("liked_tracks"));
+	// Index is only built once, and then kept updated
+	if (!indexed || !watchingCache)
+	{
+		refreshIndex();
+		indexed = true;
+	}
+
+	filter(query);
 }
 
 void Search::Library::search(const std::string &query)
@@ -35,26 +79,95 @@ void Search::Library::search(const std::string &query)
 		return;
 	}
 
-	spotify.saved_tracks([this, query](const std::vector<lib::spt::track> &tracks)
+	if (savedTracksLoaded)
 	{
-		this->addResults(query, tracks);
+		searchCache(query);
+		return;
+	}
+
+	spotify.saved_tracks([this](const std::vector<lib::spt::track> &tracks)
+	{
+		savedTracksLoaded = true;
+		cache.set_tracks(savedTracksId, tracks);
+		searchCache(lastQuery);
 	});
 }
 
-void Search::Library::addResults(const std::string &query,
-	const std::vector<lib::spt::track> &tracks)
+void Search::Library::filter(const std::string &query)
 {
 	clear();
-	auto q = lib::strings::to_lower(query);
 
-	for (const auto &track: tracks)
+	for (const auto &track: index.search(query))
 	{
-		if (lib::strings::contains(lib::strings::to_lower(track.name), q)
-			|| lib::strings::contains(lib::strings::to_lower(track.album.name), q)
-			|| lib::strings::contains(lib::strings::to_lower(
-				lib::spt::entity::combine_names(track.artists)), q))
+		add(track);
+	}
+}
+
+void Search::Library::refreshIndex()
+{
+	index.set_tracks(savedTracksId, cache.get_tracks(savedTracksId));
+
+	std::unordered_set<std::string> currentIds;
+	for (const auto &playlist: cache.get_playlists())
+	{
+		index.set_tracks(playlist.id, cache.get_playlist(playlist.id).tracks);
+		currentIds.insert(playlist.id);
+	}
+
+	// Playlists that are no longer followed
+	for (const auto &playlistId: playlistIds)
+	{
+		if (currentIds.find(playlistId) == currentIds.end())
 		{
-			add(track);
+			index.remove_source(playlistId);
 		}
 	}
+
+	playlistIds = currentIds;
+}
+
+void Search::Library::onPlaylistsChanged(const std::vector<lib::spt::playlist> &playlists)
+{
+	if (!indexed)
+	{
+		return;
+	}
+
+	std::unordered_set<std::string> currentIds;
+	for (const auto &playlist: playlists)
+	{
+		// Newly followed playlists are loaded once
+		if (playlistIds.find(playlist.id) == playlistIds.end())
+		{
+			index.set_tracks(playlist.id, cache.get_playlist(playlist.id).tracks);
+		}
+		currentIds.insert(playlist.id);
+	}
+
+	for (const auto &playlistId: playlistIds)
+	{
+		if (currentIds.find(playlistId) == currentIds.end())
+		{
+			index.remove_source(playlistId);
+		}
+	}
+
+	playlistIds = currentIds;
+}
+
+void Search::Library::onPlaylistChanged(const lib::spt::playlist &playlist)
+{
+	if (indexed && playlistIds.find(playlist.id) != playlistIds.end())
+	{
+		index.set_tracks(playlist.id, playlist.tracks);
+	}
+}
+
+void Search::Library::onTracksChanged(const std::string &entityId,
+	const std::vector<lib::spt::track> &tracks)
+{
+	if (indexed && entityId == savedTracksId)
+	{
+		index.set_tracks(entityId, tracks);
+	}
 }
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "lib/spotify/api.hpp"
+#include "lib/search/trackindex.hpp"
+#include "lib/cache/memorycache.hpp"
 #include "view/search/tracks.hpp"
 
+#include <unordered_set>
+
 namespace Search
 {
 	class Library: public Tracks
@@ -15,15 +19,36 @@ namespace Search
 		/** Searches in cache */
 		void searchCache(const std::string &query);
 
-		/** Makes a new request and searches saved tracks */
+		/** Searches saved tracks, and cache, loading saved tracks the first time */
 		void search(const std::string &query);
 
+		/** Searches already indexed tracks, without checking cache for changes */
+		void filter(const std::string &query);
+
 	private:
 		lib::spt::api &spotify;
 		lib::cache &cache;
 		std::string lastQuery;
 
-		void addResults(const std::string &query,
+		lib::track_index index;
+		std::unordered_set<std::string> playlistIds;
+		bool savedTracksLoaded = false;
+
+		/** Index has been built from cache */
+		bool indexed = false;
+
+		/** Index is updated when cache changes, instead of before searching */
+		bool watchingCache = false;
+
+		/** Cache ID of saved tracks */
+		static constexpr const char *savedTracksId = "liked_tracks";
+
+		/** Update index with any changes in cache */
+		void refreshIndex();
+
+		void onPlaylistsChanged(const std::vector<lib::spt::playlist> &playlists);
+		void onPlaylistChanged(const lib::spt::playlist &playlist);
+		void onTracksChanged(const std::string &entityId,
 			const std::vector<lib::spt::track> &tracks);
 	};
 }
@@ -2,11 +2,11 @@
 #include "mainwindow.hpp"
 
 Search::View::View(lib::spt::api &spotify, lib::cache &cache,
-	const lib::http_client &httpClient, QWidget *parent)
+	lib::image_loader &imageLoader, QWidget *parent)
 	: QWidget(parent),
 	spotify(spotify),
 	cache(cache),
-	httpClient(httpClient)
+	imageLoader(imageLoader)
 {
 	auto *layout = new QVBoxLayout();
 	searchBox = new QLineEdit(this);
@@ -21,7 +21,7 @@ Search::View::View(lib::spt::api &spotify, lib::cache &cache,
 	artists = new Search::Artists(this);
 	playlists = new Search::Playlists(spotify, cache, this);
 	tracks = new Search::Tracks(spotify, cache, this);
-	albums = new Search::Albums(spotify, cache, httpClient, this);
+	albums = new Search::Albums(spotify, cache, imageLoader, this);
 	library = new Search::Library(spotify, cache, this);
 	shows = new Search::Shows(spotify, this);
 
@@ -37,6 +37,10 @@ Search::View::View(lib::spt::api &spotify, lib::cache &cache,
 	QLineEdit::connect(searchBox, &QLineEdit::returnPressed,
 		this, &Search::View::search);
 
+	// Library is searched locally, so it can be searched while typing
+	QLineEdit::connect(searchBox, &QLineEdit::textChanged,
+		this, &Search::View::onTextChanged);
+
 	// Searching in library is a separate request,
 	// so only actually search once requested
 	QTabWidget::connect(tabs, &QTabWidget::currentChanged,
@@ -216,3 +220,11 @@ void Search::View::onIndexChanged(int index)
 		library->search(searchText.toStdString());
 	}
 }
+
+void Search::View::onTextChanged(const QString &text)
+{
+	if (static_cast<SearchTab>(tabs->currentIndex()) == SearchTab::Library)
+	{
+		library->filter(text.toStdString());
+	}
+}
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "lib/spotify/api.hpp"
-#include "lib/httpclient.hpp"
+#include "lib/imageloader.hpp"
 
 #include "enum/searchtab.hpp"
 #include "view/search/tracks.hpp"
@@ -27,14 +27,14 @@ namespace Search
 
 	public:
 		View(lib::spt::api &spotify, lib::cache &cache,
-			const lib::http_client &httpClient, QWidget *parent);
+			lib::image_loader &imageLoader, QWidget *parent);
 
 	private:
 		QTabWidget *tabs = nullptr;
 		QLineEdit *searchBox = nullptr;
 		lib::spt::api &spotify;
 		lib::cache &cache;
-		const lib::http_client &httpClient;
+		lib::image_loader &imageLoader;
 
 		Tracks *tracks = nullptr;
 		Artists *artists = nullptr;
@@ -55,5 +55,6 @@ namespace Search
 		void resultsLoaded(const lib::spt::search_results &results);
 
 		void onIndexChanged(int index);
+		void onTextChanged(const QString &text);
 	};
 }
@@ -2,12 +2,14 @@
 #include "mainwindow.hpp"
 
 SidePanel::View::View(lib::spt::api &spotify, const lib::settings &settings,
-	lib::cache &cache, const lib::http_client &httpClient, QWidget *parent)
+	lib::cache &cache, const lib::http_client &httpClient, lib::image_loader &imageLoader,
+	QWidget *parent)
 	: QDockWidget(parent),
 	spotify(spotify),
 	settings(settings),
 	cache(cache),
-	httpClient(httpClient)
+	httpClient(httpClient),
+	imageLoader(imageLoader)
 {
 	title = new SidePanel::Title(this);
 	setTitleBarWidget(title);
@@ -29,7 +31,8 @@ SidePanel::View::View(lib::spt::api &spotify, const lib::settings &settings,
 
 void SidePanel::View::openArtist(const std::string &artistId)
 {
-	auto *view = new Artist::View(spotify, artistId, cache, httpClient, this);
+	auto *view = new Artist::View(spotify, artistId, cache, httpClient,
+		imageLoader, this);
 	addTab(view, "view-media-artist", "...",
 		SidePanelType::Artist, QString::fromStdString(artistId));
 }
@@ -77,7 +80,7 @@ void SidePanel::View::openSearch()
 {
 	if (searchView == nullptr)
 	{
-		searchView = new Search::View(spotify, cache, httpClient, this);
+		searchView = new Search::View(spotify, cache, imageLoader, this);
 	}
 
 	if (stack->indexOf(searchView) < 0)
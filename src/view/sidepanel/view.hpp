@@ -19,7 +19,7 @@ namespace SidePanel
 
 	public:
 		View(lib::spt::api &spotify, const lib::settings &settings, lib::cache &cache,
-			const lib::http_client &httpClient, QWidget *parent);
+			const lib::http_client &httpClient, lib::image_loader &imageLoader, QWidget *parent);
 
 		void openArtist(const std::string &artistId);
 		void openAudioFeatures(const std::vector<lib::spt::track> &tracks);
@@ -47,6 +47,7 @@ namespace SidePanel
 		const lib::settings &settings;
 		lib::cache &cache;
 		const lib::http_client &httpClient;
+		lib::image_loader &imageLoader;
 
 		void setCurrentIndex(int index);
 		void setCurrentWidget(QWidget *widget);